@@ -1,5 +1,7 @@
 #include <string>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "Card.h"
 
@@ -83,3 +85,20 @@ List<Card> shuffle(const List<Card>& deck) {
     // }
     return ret;
 }
+
+void shuffle(List<Card>& deck, DeckRng& rng) {
+    // one slot per card, kept between calls so dealing hand after hand
+    // does not allocate
+    thread_local std::vector<List<Card>::const_iterator> order;
+    order.clear();
+    for (auto it = deck.cbegin(); it != deck.cend(); ++it) {
+        order.push_back(it);
+    }
+    for (size_t i = order.size(); i > 1; i--) {
+        std::swap(order[i - 1], order[rng.below(i)]);
+    }
+    // moving every node to the back in turn leaves them in that order
+    for (const auto& it : order) {
+        deck.splice(deck.cend(), deck, it);
+    }
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 
+#include "DeckRng.h"
 #include "List.h"
 
 enum class Suit { SPADES, DIAMONDS, CLUBS, HEARTS };
@@ -18,10 +20,38 @@ struct Card {
     Rank rank;
 };
 
+// A card in one byte, the suit above the four bits of the rank, for code
+// that keeps many decks side by side
+struct PackedCard {
+    uint8_t bits;
+
+    PackedCard() = default;
+    constexpr explicit PackedCard(const Card& card) noexcept
+    : bits{static_cast<uint8_t>(static_cast<unsigned>(card.suit) << 4 | static_cast<unsigned>(card.rank))} {}
+
+    constexpr Suit suit() const noexcept {
+        return static_cast<Suit>(bits >> 4);
+    }
+    constexpr Rank rank() const noexcept {
+        return bits & 0xF;
+    }
+    constexpr Card unpack() const noexcept {
+        return Card{suit(), rank()};
+    }
+};
+
+static_assert(sizeof(PackedCard) == 1, "a packed card is one byte");
+
 List<Card> buildDeck(std::istream& file);
 
 List<Card> shuffle(const List<Card>& deck);
 
+// Shuffles deck in place with a Fisher-Yates pass driven by rng. The
+// nodes are relinked rather than copied, every permutation is equally
+// likely, and a given seed always deals the same order. The shuffle
+// above stays the one driven by rand221.
+void shuffle(List<Card>& deck, DeckRng& rng);
+
 /*
     Use the "rand221" function to generate random numbers 
     for your shuffling algorithm. It is effectivly the same as 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+// xoshiro256** seeded through splitmix64, as in the test tree's
+// xoshiro256, for shuffles that run millions of times. The same seed
+// always gives the same stream. jump() skips 2^128 values ahead, so
+// seeding one generator and jumping once per copy gives each worker a
+// stream that never overlaps another.
+class DeckRng {
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = uint64_t;
+
+    explicit DeckRng(uint64_t seed) noexcept {
+        for (uint64_t& word : s) {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() noexcept {
+        return 0;
+    }
+    static constexpr result_type max() noexcept {
+        return UINT64_MAX;
+    }
+
+    result_type operator()() noexcept {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // A value in [0, bound) by multiplying out the top 32 bits. The bias
+    // is below bound / 2^32, far under what a deck of cards can show.
+    size_t below(size_t bound) noexcept {
+        return static_cast<size_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+    void jump() noexcept {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t t[4] = { 0, 0, 0, 0 };
+        for (uint64_t word : JUMP) {
+            for (int b = 0; b < 64; b++) {
+                if (word & (uint64_t(1) << b)) {
+                    t[0] ^= s[0];
+                    t[1] ^= s[1];
+                    t[2] ^= s[2];
+                    t[3] ^= s[3];
+                }
+                (*this)();
+            }
+        }
+        s[0] = t[0];
+        s[1] = t[1];
+        s[2] = t[2];
+        s[3] = t[3];
+    }
+};
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <stdexcept> // std::invalid_argument
+#include <type_traits> // std::enable_if, std::is_same
+
+// The links an object carries to sit in an IntrusiveList. An object can
+// be in as many lists at once as it has hooks. A hook leaves its list on
+// unlink() or when it is destroyed, and a copied object starts out in no
+// list at all.
+class ListHook {
+    template <class T, ListHook T::*Hook>
+    friend class IntrusiveList;
+
+    ListHook *next, *prev;
+
+public:
+    ListHook() noexcept : next{nullptr}, prev{nullptr} {}
+    ListHook(const ListHook&) noexcept : ListHook() {}
+    ListHook& operator=(const ListHook&) noexcept {
+        return *this;
+    }
+    ~ListHook() {
+        unlink();
+    }
+
+    bool linked() const noexcept {
+        return next != nullptr;
+    }
+
+    // Takes the object out of its list in O(1), without the list
+    void unlink() noexcept {
+        if (next != nullptr) {
+            prev->next = next;
+            next->prev = prev;
+            next = prev = nullptr;
+        }
+    }
+};
+
+// A list of objects that are linked through their own Hook member rather
+// than copied into nodes, so push, insert, erase and splice never
+// allocate. The list does not own its objects: erase and clear only
+// unlink them, and an object must outlive its time in the list unless it
+// is destroyed, which unlinks it.
+//
+// Since an object can leave through its hook behind the list's back, the
+// list keeps no count. size() walks the list; empty() does not.
+template <class T, ListHook T::*Hook>
+class IntrusiveList {
+    private:
+    // Offset of the hook inside T, taken on an object that is never
+    // constructed; optimized builds fold it to a constant
+    static ptrdiff_t _hook_offset() noexcept {
+        union Probe {
+            Probe() {}
+            ~Probe() {}
+            T object;
+            char bytes[sizeof(T)];
+        } probe;
+        return reinterpret_cast<char*>(&(probe.object.*Hook)) - probe.bytes;
+    }
+    static T* _owner(ListHook* hook) noexcept {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - _hook_offset());
+    }
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+    private:
+        friend class IntrusiveList;
+
+        ListHook* node;
+    public:
+        basic_iterator() {
+            node = nullptr;
+        }
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        explicit basic_iterator(const ListHook* ptr) noexcept : node{const_cast<ListHook*>(ptr)} {}
+
+        // iterator converts to const_iterator, not the other way around
+        template <typename P, typename R, typename = typename std::enable_if<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>::type>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : node{other.node} {}
+
+        reference operator*() const {
+            return *_owner(node);
+        }
+        pointer operator->() const {
+            return _owner(node);
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator hold = basic_iterator(node);
+            node = node->next;
+            return hold;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            node = node->prev;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator hold = basic_iterator(node);
+            node = node->prev;
+            return hold;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.node == rhs.node;
+        }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.node != rhs.node;
+        }
+
+        template <typename P, typename R>
+        friend class basic_iterator;
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+private:
+    // head.next is the first object and head.prev the last; an empty list
+    // points at itself
+    ListHook head;
+
+    void _make_empty() noexcept {
+        head.next = head.prev = &head;
+    }
+
+    // Moves the hooks [first, last) in front of pos. Only links change.
+    static void _transfer(ListHook* pos, ListHook* first, ListHook* last) noexcept {
+        if (first == last || pos == first || pos == last) {
+            return;
+        }
+        ListHook* final = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+        first->prev = pos->prev;
+        final->next = pos;
+        pos->prev->next = first;
+        pos->prev = final;
+    }
+
+public:
+    IntrusiveList() noexcept {
+        _make_empty();
+    }
+
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& other) noexcept {
+        _make_empty();
+        splice(cend(), other);
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(cend(), other);
+        }
+        return *this;
+    }
+
+    ~IntrusiveList() {
+        clear();
+    }
+
+    reference front() {
+        return *_owner(head.next);
+    }
+    const_reference front() const {
+        return *_owner(head.next);
+    }
+
+    reference back() {
+        return *_owner(head.prev);
+    }
+    const_reference back() const {
+        return *_owner(head.prev);
+    }
+
+    iterator begin() noexcept {
+        return iterator(head.next);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head.next);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(head.next);
+    }
+
+    iterator end() noexcept {
+        return iterator(&head);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(&head);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(&head);
+    }
+
+    // The position of value, which must be in this list, in O(1)
+    iterator iterator_to(T& value) noexcept {
+        return iterator(&(value.*Hook));
+    }
+    const_iterator iterator_to(const T& value) const noexcept {
+        return const_iterator(&(value.*Hook));
+    }
+
+    bool empty() const noexcept {
+        return head.next == &head;
+    }
+
+    // Linear, see above
+    size_type size() const noexcept {
+        size_type count = 0;
+        for (const ListHook* hook = head.next; hook != &head; hook = hook->next) {
+            count++;
+        }
+        return count;
+    }
+
+    // Unlinks every object, leaving them all free to join another list
+    void clear() noexcept {
+        ListHook* hook = head.next;
+        while (hook != &head) {
+            ListHook* next = hook->next;
+            hook->next = hook->prev = nullptr;
+            hook = next;
+        }
+        _make_empty();
+    }
+
+    // Links value in front of pos. Throws std::invalid_argument if its
+    // hook is already in a list.
+    iterator insert( const_iterator pos, T& value ) {
+        ListHook* hook = &(value.*Hook);
+        if (hook->linked()) {
+            throw std::invalid_argument("IntrusiveList: object is already linked");
+        }
+        hook->next = pos.node;
+        hook->prev = pos.node->prev;
+        pos.node->prev->next = hook;
+        pos.node->prev = hook;
+        return iterator(hook);
+    }
+
+    // Unlinks the object at pos and returns the position after it
+    iterator erase( const_iterator pos ) noexcept {
+        iterator hold = iterator(pos.node->next);
+        pos.node->unlink();
+        return hold;
+    }
+
+    void push_back( T& value ) {
+        insert(cend(), value);
+    }
+    void push_front( T& value ) {
+        insert(cbegin(), value);
+    }
+
+    void pop_back() noexcept {
+        head.prev->unlink();
+    }
+    void pop_front() noexcept {
+        head.next->unlink();
+    }
+
+    // Moves every object of other in front of pos in O(1)
+    void splice( const_iterator pos, IntrusiveList& other ) noexcept {
+        _transfer(pos.node, other.head.next, &other.head);
+    }
+    // Moves the object at it from other in front of pos
+    void splice( const_iterator pos, IntrusiveList&, const_iterator it ) noexcept {
+        _transfer(pos.node, it.node, it.node->next);
+    }
+    // Moves [first, last) from other in front of pos, which must not be in
+    // the range. O(1), there are no sizes to keep.
+    void splice( const_iterator pos, IntrusiveList&, const_iterator first, const_iterator last ) noexcept {
+        _transfer(pos.node, first.node, last.node);
+    }
+
+    iterator insert( iterator pos, T& value ) {
+        return insert(const_iterator(pos), value);
+    }
+    iterator erase( iterator pos ) noexcept {
+        return erase(const_iterator(pos));
+    }
+};
@@ -1,22 +1,32 @@
 #pragma once
 
 #include <cstddef> // size_t
+#include <functional> // std::less
 #include <iterator> // std::bidirectional_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
+#include <type_traits> // std::enable_if, std::is_trivially_destructible
+#include <utility> // std::move, std::forward, std::declval
 
-template <class T>
+// Nodes come from Allocator rebound to the node type. Pass a NodePool
+// (NodePool.h) to take them from slabs instead of one new per node.
+template <class T, class Allocator = std::allocator<T>>
 class List {
     private:
-    struct Node {
-        Node *next, *prev;
+    // The sentinels only need the links, so they hold no T at all
+    struct Link {
+        Link *next, *prev;
+    };
+    struct Node : Link {
         T data;
-        explicit Node(Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev}, data{} {}
-        explicit Node(const T& data, Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev}, data{data} {}
-        explicit Node(T&& data, Node* prev = nullptr, Node* next = nullptr)
-        : next{next}, prev{prev}, data{std::move(data)} {}
+        template <class... Args>
+        explicit Node(Args&&... args)
+        : Link{nullptr, nullptr}, data(std::forward<Args>(args)...) {}
     };
 
+    static T& _value(Link* link) noexcept {
+        return static_cast<Node*>(link)->data;
+    }
+
     template <typename pointer_type, typename reference_type>
     class basic_iterator {
     public:
@@ -25,11 +35,14 @@ class List {
         using difference_type   = ptrdiff_t;
         using pointer           = pointer_type;
         using reference         = reference_type;
+        using list_type         = List;
     private:
-        friend class List<value_type>;
-        using Node = typename List<value_type>::Node;
+        friend class List;
+        template <typename, typename>
+        friend class basic_iterator;
+        using Link = typename List::Link;
 
-        Node* node;
+        Link* node;
     public:
         basic_iterator() {
             node = nullptr;
@@ -40,15 +53,20 @@ class List {
         basic_iterator& operator=(const basic_iterator&) = default;
         basic_iterator& operator=(basic_iterator&&) = default;
 
-        explicit basic_iterator(Node* ptr) noexcept : node{ptr} {}
+        explicit basic_iterator(Link* ptr) noexcept : node{ptr} {}
 
-        explicit basic_iterator(const Node* ptr) noexcept : node{const_cast<Node*>(ptr)} {}
+        explicit basic_iterator(const Link* ptr) noexcept : node{const_cast<Link*>(ptr)} {}
+
+        // An iterator converts to a const_iterator at the same node
+        template <typename other_pointer, typename other_reference,
+                  typename = std::enable_if_t<std::is_same<other_pointer, T*>::value && !std::is_same<pointer_type, T*>::value>>
+        basic_iterator(const basic_iterator<other_pointer, other_reference>& other) noexcept : node{other.node} {}
 
         reference operator*() const {
-            return node->data;
+            return _value(node);
         }
         pointer operator->() const {
-            return &(node->data);
+            return &_value(node);
         }
 
         // Prefix Increment: ++a
@@ -92,22 +110,145 @@ public:
     using const_pointer   = const value_type*;
     using iterator        = basic_iterator<pointer, reference>;
     using const_iterator  = basic_iterator<const_pointer, const_reference>;
+    using allocator_type  = Allocator;
 
 private:
-    Node head, tail;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits    = std::allocator_traits<node_allocator>;
+
+    // Allocators that can drop all of their memory at once, like NodePool
+    template <class A, class = void>
+    struct can_release : std::false_type {};
+    template <class A>
+    struct can_release<A, decltype(std::declval<A&>().release())> : std::true_type {};
+
+    Link head, tail;
     size_type _size;
+    node_allocator _alloc;
+
+    template <class... Args>
+    Node* _create(Args&&... args) {
+        Node* node = node_traits::allocate(_alloc, 1);
+        try {
+            node_traits::construct(_alloc, node, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            node_traits::deallocate(_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void _destroy(Link* link) noexcept {
+        Node* node = static_cast<Node*>(link);
+        node_traits::destroy(_alloc, node);
+        node_traits::deallocate(_alloc, node, 1);
+    }
+
+    // Destroys every node. A pool hands back its slabs in one go instead of
+    // taking each node back, and nodes that need no destructor are not
+    // even visited.
+    void _destroy_all() noexcept {
+        if constexpr (can_release<node_allocator>::value) {
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                for (Link* link = head.next; link != &tail;) {
+                    Link* next = link->next;
+                    node_traits::destroy(_alloc, static_cast<Node*>(link));
+                    link = next;
+                }
+            }
+            _alloc.release();
+        }
+        else {
+            while (head.next != &tail) {
+                head.next = head.next->next;
+                _destroy(head.next->prev);
+            }
+        }
+        head.next = &tail;
+        tail.prev = &head;
+        _size = 0;
+    }
+
+    // Moves the nodes [first, last) in front of pos. Only links change.
+    static void _transfer(Link* pos, Link* first, Link* last) noexcept {
+        if (first == last || pos == first || pos == last) {
+            return;
+        }
+        Link* final = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+        first->prev = pos->prev;
+        final->next = pos;
+        pos->prev->next = first;
+        pos->prev = final;
+    }
+
+    // Nodes can only change lists when either allocator can free them
+    bool _shares_nodes(const List& other) const noexcept {
+        return node_traits::is_always_equal::value || _alloc == other._alloc;
+    }
+
+    // Merges the null terminated chains a and b into out. a holds the
+    // earlier elements, so ties take from a and the merge is stable. If
+    // comp throws, out still ends up holding every node of both chains.
+    template <class Compare>
+    static void _merge_chains(Link*& out, Link* a, Link* b, Compare& comp) {
+        out = nullptr;
+        Link** link = &out;
+        try {
+            while (a != nullptr && b != nullptr) {
+                if (comp(_value(b), _value(a))) {
+                    *link = b;
+                    b = b->next;
+                }
+                else {
+                    *link = a;
+                    a = a->next;
+                }
+                link = &(*link)->next;
+            }
+        }
+        catch (...) {
+            *link = a;
+            while (*link != nullptr) {
+                link = &(*link)->next;
+            }
+            *link = b;
+            throw;
+        }
+        *link = a != nullptr ? a : b;
+    }
+
+    // Puts the null terminated chain back between the sentinels and
+    // restores the prev links
+    void _relink(Link* chain) noexcept {
+        Link* prev = &head;
+        for (; chain != nullptr; chain = chain->next) {
+            prev->next = chain;
+            chain->prev = prev;
+            prev = chain;
+        }
+        prev->next = &tail;
+        tail.prev = prev;
+    }
 
 public:
-    List() : head(), tail(), _size(0) {
+    List() : head(), tail(), _size(0), _alloc() {
         head.next = &tail;
         tail.prev = &head;
     }
 
-    List(size_type count, const T& value    ) : head(), tail(), _size(0) { 
+    explicit List(const Allocator& alloc) : head(), tail(), _size(0), _alloc(alloc) {
         head.next = &tail;
         tail.prev = &head;
-        for (int i = 0; i < count; i++) {
-            Node* new_node = new Node(value);
+    }
+
+    List(size_type count, const T& value, const Allocator& alloc = Allocator()) : head(), tail(), _size(0), _alloc(alloc) {
+        head.next = &tail;
+        tail.prev = &head;
+        for (size_type i = 0; i < count; i++) {
+            Link* new_node = _create(value);
             head.next->prev = new_node;
             new_node->next = head.next;
             head.next = new_node;
@@ -116,11 +257,11 @@ public:
         }
     }
 
-    explicit List(size_type count) : head(), tail(), _size(0) {
+    explicit List(size_type count, const Allocator& alloc = Allocator()) : head(), tail(), _size(0), _alloc(alloc) {
         head.next = &tail;
         tail.prev = &head;
         for (size_type i = 0; i < count; i++) {
-            Node* new_node = new Node(T());
+            Link* new_node = _create();
             head.next->prev = new_node;
             new_node->next = head.next;
             head.next = new_node;
@@ -129,13 +270,13 @@ public:
         }
     }
 
-    List( const List& other ) : head(), tail(), _size(0){
+    List( const List& other ) : head(), tail(), _size(0), _alloc(node_traits::select_on_container_copy_construction(other._alloc)) {
         head.next = &tail;
         tail.prev = &head;
         iterator hold = iterator(&other.tail);
         for (size_type i = 0; i < other._size; i++) {
             --hold;
-            Node* new_node = new Node(hold.node->data);
+            Link* new_node = _create(_value(hold.node));
             head.next->prev = new_node;
             new_node->next = head.next;
             head.next = new_node;
@@ -144,7 +285,7 @@ public:
         }
     }
 
-    List( List&& other ) : head(), tail(), _size(0){
+    List( List&& other ) : head(), tail(), _size(0), _alloc(std::move(other._alloc)) {
         if (other.empty()) {
             head.next = &tail;
             tail.prev = &head;
@@ -162,14 +303,7 @@ public:
     }
 
     ~List() {
-        while (head.next != &tail) {
-            head.next = head.next->next;
-            delete head.next->prev;
-            head.next->prev = &head;
-        }
-        _size = 0;
-        head.next = &tail;
-        tail.prev = &head;
+        _destroy_all();
     }
 
     List& operator=(const List& other ) {
@@ -180,7 +314,7 @@ public:
         iterator hold = iterator(&other.tail);
         for (size_type i = 0; i < other._size; i++) {
             --hold;
-            Node* new_node = new Node(hold.node->data);
+            Link* new_node = _create(_value(hold.node));
             head.next->prev = new_node;
             new_node->next = head.next;
             head.next = new_node;
@@ -190,12 +324,23 @@ public:
         return *this;
     }
 
-    List& operator=(List&& other ) noexcept {
+    List& operator=(List&& other ) noexcept(node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value) {
         
         if (const_iterator(head.next) == const_iterator(other.head.next)) {
             return *this;
         }
         this->clear();
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            _alloc = std::move(other._alloc);
+        }
+        else if (_alloc != other._alloc) {
+            // the nodes can not change hands, so move the elements over
+            for (T& value : other) {
+                push_back(std::move(value));
+            }
+            other.clear();
+            return *this;
+        }
         if (other.empty()) {
             head.next = &tail;
             tail.prev = &head;
@@ -218,20 +363,20 @@ public:
     }
 
     reference front() {
-        return ((head.next)->data);
+        return _value(head.next);
     }
 
     const_reference front() const {
-        const_reference hold = ((head.next)->data);
+        const_reference hold = _value(head.next);
         return hold;
     }
 	
     reference back() {
-        return ((tail.prev)->data);
+        return _value(tail.prev);
     }
 
     const_reference back() const {
-        const_reference hold = ((tail.prev)->data);
+        const_reference hold = _value(tail.prev);
         return hold;
     }
 	
@@ -271,19 +416,18 @@ public:
         return _size;
     }
 
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_alloc);
+    }
+
     void clear() noexcept {
-        while (head.next != &tail) {
-           head.next = head.next->next;
-           delete head.next->prev;
-           head.next->prev = &head;
-       }
-       head.next = &tail;
-       tail.prev = &head;
-       _size = 0;
+        _destroy_all();
     }
 
-    iterator insert( const_iterator pos, const T& value ) {
-        Node* new_node = new Node(value);
+    // Constructs the element in place in front of pos from args
+    template <class... Args>
+    iterator emplace( const_iterator pos, Args&&... args ) {
+        Link* new_node = _create(std::forward<Args>(args)...);
         new_node->next = pos.node;
         new_node->prev = pos.node->prev;
         pos.node->prev->next = new_node;
@@ -291,82 +435,231 @@ public:
         _size += 1;
         return iterator(new_node);
     }
+
+    iterator insert( const_iterator pos, const T& value ) {
+        return emplace(pos, value);
+    }
     iterator insert( const_iterator pos, T&& value ) {
-        Node* new_node = new Node(std::move(value));
-        new_node->next = pos.node;
-        new_node->prev = pos.node->prev;
-        pos.node->prev->next = new_node;
-        pos.node->prev = new_node;
-        _size += 1;
-        return iterator(new_node);
+        return emplace(pos, std::move(value));
     }
 
     iterator erase( const_iterator pos ) {
         pos.node->prev->next = pos.node->next;
         pos.node->next->prev = pos.node->prev;
         iterator hold = iterator(pos.node->next);
-        delete pos.node;
+        _destroy(pos.node);
         _size -= 1;
         return hold;
     }
 
-    void push_back( const T& value ) {
-        Node* new_node = new Node(value);
+    template <class... Args>
+    reference emplace_back( Args&&... args ) {
+        Link* new_node = _create(std::forward<Args>(args)...);
         tail.prev->next = new_node;
         new_node->prev = tail.prev;
         tail.prev = new_node;
         new_node->next = &tail;
         _size += 1;
+        return _value(new_node);
+    }
+
+    void push_back( const T& value ) {
+        emplace_back(value);
     }
     void push_back( T&& value ) {
-        Node* new_node = new Node(std::move(value));
-        tail.prev->next = new_node;
-        new_node->prev = tail.prev;
-        tail.prev = new_node;
-        new_node->next = &tail;
-        _size += 1;
+        emplace_back(std::move(value));
     }
 
     void pop_back() {
         tail.prev = tail.prev->prev;
-        delete tail.prev->next;
+        _destroy(tail.prev->next);
         tail.prev->next = &tail;
         _size -= 1;
     }
 	
-    void push_front( const T& value ) {
-        Node* new_node = new Node(value);
+    template <class... Args>
+    reference emplace_front( Args&&... args ) {
+        Link* new_node = _create(std::forward<Args>(args)...);
         head.next->prev = new_node;
         new_node->next = head.next;
         head.next = new_node;
         new_node->prev = &head;
         _size += 1;
+        return _value(new_node);
     }
-	void push_front( T&& value ) {
-        Node* new_node = new Node(std::move(value));
-        head.next->prev = new_node;
-        new_node->next = head.next;
-        head.next = new_node;
-        new_node->prev = &head;
-        _size += 1;
+
+    void push_front( const T& value ) {
+        emplace_front(value);
+    }
+    void push_front( T&& value ) {
+        emplace_front(std::move(value));
     }
 
     void pop_front() {
         head.next = head.next->next;
-        delete head.next->prev;
+        _destroy(head.next->prev);
         head.next->prev = &head;
         _size -= 1;
     }
     iterator insert( iterator pos, const T & value) { 
-        return insert((const_iterator &) (pos), value);
+        return insert(const_iterator(pos.node), value);
     }
 
     iterator insert( iterator pos, T && value ) {
-        return insert((const_iterator &) (pos), std::move(value));
+        return insert(const_iterator(pos.node), std::move(value));
     }
 
     iterator erase( iterator pos ) {
-        return erase((const_iterator&)(pos));
+        return erase(const_iterator(pos.node));
+    }
+
+    // Moves every element of other in front of pos in O(1). When the two
+    // allocators can not free each other's nodes, as for two NodePools,
+    // the elements are moved instead, one node at a time.
+    void splice( const_iterator pos, List& other ) {
+        splice(pos, other, other.cbegin(), other.cend());
+    }
+    void splice( const_iterator pos, List&& other ) {
+        splice(pos, other);
+    }
+
+    // Moves the element at it from other in front of pos
+    void splice( const_iterator pos, List& other, const_iterator it ) {
+        const_iterator next = it;
+        splice(pos, other, it, ++next);
+    }
+    void splice( const_iterator pos, List&& other, const_iterator it ) {
+        splice(pos, other, it);
+    }
+
+    // Moves [first, last) from other in front of pos, which must not be in
+    // the range. Linear in the range length only when the sizes need
+    // counting, that is when other is a different list.
+    void splice( const_iterator pos, List& other, const_iterator first, const_iterator last ) {
+        if (first == last) {
+            return;
+        }
+        if (this == &other) {
+            _transfer(pos.node, first.node, last.node);
+            return;
+        }
+        if (!_shares_nodes(other)) {
+            while (first != last) {
+                Link* next = first.node->next;
+                insert(pos, std::move(_value(first.node)));
+                other.erase(first);
+                first = const_iterator(next);
+            }
+            return;
+        }
+        size_type count = 0;
+        if (first == other.cbegin() && last == other.cend()) {
+            count = other._size;
+        }
+        else {
+            for (const_iterator it = first; it != last; ++it) {
+                count++;
+            }
+        }
+        _transfer(pos.node, first.node, last.node);
+        _size += count;
+        other._size -= count;
+    }
+    void splice( const_iterator pos, List&& other, const_iterator first, const_iterator last ) {
+        splice(pos, other, first, last);
+    }
+
+    // Merges the sorted list other into this sorted list in one pass,
+    // relinking its nodes, or moving its elements when splice has to.
+    // Stable: of equal elements, the ones already in this list come first.
+    void merge( List& other ) {
+        merge(other, std::less<T>());
+    }
+    void merge( List&& other ) {
+        merge(other);
+    }
+    template <class Compare>
+    void merge( List& other, Compare comp ) {
+        if (this == &other) {
+            return;
+        }
+        const_iterator it = cbegin();
+        while (!other.empty()) {
+            if (it == cend()) {
+                splice(it, other);
+                return;
+            }
+            if (comp(other.front(), *it)) {
+                splice(it, other, other.cbegin());
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+    template <class Compare>
+    void merge( List&& other, Compare comp ) {
+        merge(other, comp);
+    }
+
+    // Stable bottom-up merge sort in O(n log n) that only relinks nodes;
+    // no element is copied, moved or swapped. If comp throws, every
+    // element is still in the list, in some order.
+    void sort() {
+        sort(std::less<T>());
+    }
+    template <class Compare>
+    void sort( Compare comp ) {
+        if (_size < 2) {
+            return;
+        }
+        // bins[i] is empty or a sorted chain of 2^i nodes, and any higher
+        // bin holds earlier nodes than a lower one
+        Link* bins[sizeof(size_type) * 8] = {};
+        Link* rest = head.next;
+        Link* chain = nullptr;
+        tail.prev->next = nullptr;
+        try {
+            while (rest != nullptr) {
+                chain = rest;
+                rest = rest->next;
+                chain->next = nullptr;
+                size_t i = 0;
+                for (; bins[i] != nullptr; i++) {
+                    Link* earlier = bins[i];
+                    bins[i] = nullptr;
+                    Link* later = chain;
+                    _merge_chains(chain, earlier, later, comp);
+                }
+                bins[i] = chain;
+                chain = nullptr;
+            }
+            for (Link*& bin : bins) {
+                if (bin != nullptr) {
+                    Link* earlier = bin;
+                    bin = nullptr;
+                    Link* later = chain;
+                    _merge_chains(chain, earlier, later, comp);
+                }
+            }
+        }
+        catch (...) {
+            // gather whatever is where back into one chain
+            Link** link = &chain;
+            while (*link != nullptr) {
+                link = &(*link)->next;
+            }
+            for (Link* bin : bins) {
+                *link = bin;
+                while (*link != nullptr) {
+                    link = &(*link)->next;
+                }
+            }
+            *link = rest;
+            _relink(chain);
+            throw;
+        }
+        _relink(chain);
     }
 };
 
@@ -374,30 +667,30 @@ namespace {
     template<typename Iter, typename ConstIter, typename T>
     using enable_for_list_iters = typename std::enable_if<
         std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::iterator, 
+            typename Iter::list_type::iterator, 
             Iter
         >{} && std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::const_iterator,
+            typename Iter::list_type::const_iterator,
             ConstIter
         >{}, T>::type;
 }
 
 template<typename Iterator, typename ConstIter>
 enable_for_list_iters<Iterator, ConstIter, bool> operator==(const Iterator & lhs, const ConstIter & rhs) {
-    return (const ConstIter &)(lhs) == rhs;
+    return ConstIter(lhs) == rhs;
 }
 
 template<typename Iterator, typename ConstIter>
 enable_for_list_iters<Iterator, ConstIter, bool> operator==(const ConstIter & lhs, const Iterator & rhs) {
-    return (const ConstIter &)(rhs) == lhs;
+    return ConstIter(rhs) == lhs;
 }
 
 template<typename Iterator, typename ConstIter>
 enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const Iterator & lhs, const ConstIter & rhs) {
-    return (const ConstIter &)(lhs) != rhs;
+    return ConstIter(lhs) != rhs;
 }
 
 template<typename Iterator, typename ConstIter>
 enable_for_list_iters<Iterator, ConstIter, bool> operator!=(const ConstIter & lhs, const Iterator & rhs) {
-    return (const ConstIter &)(rhs) != lhs;
+    return ConstIter(rhs) != lhs;
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <new> // ::operator new
+#include <type_traits> // std::true_type, std::false_type
+#include <utility> // std::move
+
+// An allocator for node based containers such as List<T, NodePool<T>>.
+// Single objects are carved out of slabs of NodesPerSlab slots: an
+// allocation pops the free list or bumps a pointer through the newest
+// slab, and a deallocation pushes the slot back on the free list. Slabs
+// are only returned to the system by release() or when the pool goes
+// away, so a container can drop all of its nodes at once.
+//
+// Each pool owns its slabs. A copy starts out empty, so only the pool
+// that handed out a slot (or the one it was moved into) may free it. The
+// propagation traits keep a List and its pool together on move and swap,
+// and a copied List gets a pool of its own.
+//
+// Two pools only compare equal when they are the same pool, or both hold
+// nothing. So splice and merge between two non-empty pooled Lists can not
+// relink nodes: each element is moved into a node from the destination's
+// pool, in linear time. Within one List they stay O(1).
+template <class T, size_t NodesPerSlab = 64>
+class NodePool {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <class U>
+    struct rebind {
+        using other = NodePool<U, NodesPerSlab>;
+    };
+
+private:
+    static_assert(NodesPerSlab > 0, "a slab needs at least one slot");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "slabs come from plain operator new");
+
+    // A free slot holds the link to the next free slot
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Slabs are chained through a header in front of their slots
+    struct Slab {
+        Slab* next;
+        Slot slots[NodesPerSlab];
+    };
+
+    Slab* _slabs;
+    Slot* _free;
+    Slot* _bump;
+    Slot* _bump_end;
+
+    void _take(NodePool& other) noexcept {
+        _slabs = other._slabs;
+        _free = other._free;
+        _bump = other._bump;
+        _bump_end = other._bump_end;
+        other._slabs = nullptr;
+        other._free = other._bump = other._bump_end = nullptr;
+    }
+
+    Slot* _new_slab() {
+        Slab* slab = static_cast<Slab*>(::operator new(sizeof(Slab)));
+        slab->next = _slabs;
+        _slabs = slab;
+        _bump = slab->slots + 1;
+        _bump_end = slab->slots + NodesPerSlab;
+        return slab->slots;
+    }
+
+public:
+    NodePool() noexcept : _slabs(nullptr), _free(nullptr), _bump(nullptr), _bump_end(nullptr) {}
+
+    NodePool(const NodePool&) noexcept : NodePool() {}
+
+    template <class U>
+    NodePool(const NodePool<U, NodesPerSlab>&) noexcept : NodePool() {}
+
+    NodePool(NodePool&& other) noexcept : NodePool() {
+        _take(other);
+    }
+
+    NodePool& operator=(const NodePool&) noexcept {
+        return *this;
+    }
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            release();
+            _take(other);
+        }
+        return *this;
+    }
+
+    ~NodePool() {
+        release();
+    }
+
+    NodePool select_on_container_copy_construction() const noexcept {
+        return NodePool();
+    }
+
+    T* allocate(size_t n) {
+        // arrays are not pooled
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        Slot* slot;
+        if (_free != nullptr) {
+            slot = _free;
+            _free = _free->next;
+        }
+        else if (_bump != _bump_end) {
+            slot = _bump++;
+        }
+        else {
+            slot = _new_slab();
+        }
+        return reinterpret_cast<T*>(slot);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(ptr);
+            return;
+        }
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = _free;
+        _free = slot;
+    }
+
+    // Returns every slab at once. Anything still allocated from the pool
+    // is gone afterwards, so the objects in it must already be destroyed.
+    void release() noexcept {
+        while (_slabs != nullptr) {
+            Slab* next = _slabs->next;
+            ::operator delete(_slabs);
+            _slabs = next;
+        }
+        _free = _bump = _bump_end = nullptr;
+    }
+
+    // Number of slabs currently held
+    size_t slabs() const noexcept {
+        size_t count = 0;
+        for (const Slab* slab = _slabs; slab != nullptr; slab = slab->next) {
+            count++;
+        }
+        return count;
+    }
+
+    friend void swap(NodePool& a, NodePool& b) noexcept {
+        NodePool hold(std::move(a));
+        a._take(b);
+        b._take(hold);
+    }
+
+    // Pools are only interchangeable with themselves; two empty pools
+    // hold nothing either could fail to free
+    template <class U>
+    bool operator==(const NodePool<U, NodesPerSlab>& other) const noexcept {
+        return static_cast<const void*>(this) == static_cast<const void*>(&other) || (_slabs == nullptr && other._slabs == nullptr);
+    }
+    template <class U>
+    bool operator!=(const NodePool<U, NodesPerSlab>& other) const noexcept {
+        return !(*this == other);
+    }
+
+    template <class U, size_t N>
+    friend class NodePool;
+};
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "Simulation.h"
+
+namespace {
+    // Decks dealt between tallies; a batch of 52 card decks is 13KiB of
+    // packed cards and stays in L1/L2 while it is counted
+    constexpr size_t batch_decks = 256;
+
+    SimulationStats emptyStats(size_t cards) {
+        SimulationStats stats;
+        stats.rank_at.assign(cards, {});
+        stats.suit_at.assign(cards, {});
+        return stats;
+    }
+
+    void deal(const List<Card>& ordered, size_t decks, DeckRng rng, SimulationStats& stats) {
+        List<Card> deck = ordered;
+        const size_t cards = deck.size();
+        std::vector<PackedCard> batch(batch_decks * cards);
+
+        for (size_t done = 0; done < decks;) {
+            size_t count = std::min(batch_decks, decks - done);
+
+            PackedCard* out = batch.data();
+            for (size_t i = 0; i < count; i++) {
+                shuffle(deck, rng);
+                for (const Card& card : deck) {
+                    *out++ = PackedCard(card);
+                }
+            }
+
+            const PackedCard* in = batch.data();
+            for (size_t i = 0; i < count; i++) {
+                for (size_t p = 0; p < cards; p++, in++) {
+                    stats.rank_at[p][in->rank() - 1]++;
+                    stats.suit_at[p][static_cast<size_t>(in->suit())]++;
+                }
+            }
+            done += count;
+        }
+        stats.decks = decks;
+    }
+}
+
+SimulationStats simulate(const List<Card>& deck, size_t decks, size_t threads, uint64_t seed) {
+    for (const Card& card : deck) {
+        if (card.rank < ACE || card.rank > KING) {
+            throw std::invalid_argument("simulate: card rank out of range");
+        }
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, decks));
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<SimulationStats> parts(threads, emptyStats(deck.size()));
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    DeckRng rng(seed);
+    for (size_t t = 0; t < threads; t++) {
+        // an even share, the first decks % threads workers take one more
+        size_t share = decks / threads + (t < decks % threads ? 1 : 0);
+        workers.emplace_back([&, t, share, rng]() {
+            try {
+                deal(deck, share, rng, parts[t]);
+            }
+            catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+        rng.jump();
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    SimulationStats stats = emptyStats(deck.size());
+    for (const SimulationStats& part : parts) {
+        stats.decks += part.decks;
+        for (size_t p = 0; p < deck.size(); p++) {
+            for (size_t r = 0; r < N_RANKS; r++) {
+                stats.rank_at[p][r] += part.rank_at[p][r];
+            }
+            for (size_t s = 0; s < N_SUITS; s++) {
+                stats.suit_at[p][s] += part.suit_at[p][s];
+            }
+        }
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Card.h"
+
+constexpr size_t N_RANKS = 13;
+constexpr size_t N_SUITS = 4;
+
+struct SimulationStats {
+    size_t decks = 0;
+    // rank_at[p][r - 1] counts the decks that dealt rank r at position p,
+    // suit_at[p][s] the same for suits
+    std::vector<std::array<uint64_t, N_RANKS>> rank_at;
+    std::vector<std::array<uint64_t, N_SUITS>> suit_at;
+    double seconds = 0;
+
+    double decksPerSecond() const noexcept {
+        return seconds > 0 ? decks / seconds : 0;
+    }
+};
+
+// Shuffles and deals decks copies of deck across threads workers (0 for
+// one per core) and tallies where every rank and suit landed. Each worker
+// shuffles its own copy with its own DeckRng stream, jumped from seed, and
+// deals batches of decks into packed cards before counting them. The
+// result depends only on deck, decks, threads and seed.
+//
+// Throws std::invalid_argument if a card has a rank outside ace to king.
+SimulationStats simulate(const List<Card>& deck, size_t decks, size_t threads = 0, uint64_t seed = 0x221);
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm> // std::move, std::move_backward
+#include <cstddef> // size_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <new> // placement new
+#include <type_traits> // std::enable_if
+#include <utility> // std::forward
+
+// A doubly linked list of blocks, each holding up to BlockSize elements
+// in order. Iteration walks contiguous memory and pays for one pointer
+// hop per block instead of one per element.
+//
+// The interface follows List: bidirectional iterators, insert in front of
+// a position and erase returning the position after. A full block splits
+// in half on insert, and an erase that leaves a block less than half full
+// merges it with its successor when both fit in one block. Unlike List,
+// elements move between slots when their block changes, so insert and
+// erase invalidate iterators and references into the blocks they touch.
+// Every other block is left alone, and no block is ever empty.
+template <class T, size_t BlockSize = 32>
+class UnrolledList {
+    static_assert(BlockSize >= 2, "a block must be able to split");
+
+    private:
+    // The sentinels only need the links
+    struct Link {
+        Link *next, *prev;
+    };
+    struct Block : Link {
+        size_t count;
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+
+        Block() : Link{nullptr, nullptr}, count{0} {}
+
+        T* data() noexcept {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    static Block* _block(Link* link) noexcept {
+        return static_cast<Block*>(link);
+    }
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+    private:
+        friend class UnrolledList;
+        using Link = typename UnrolledList::Link;
+
+        Link* block;
+        size_t index;
+    public:
+        basic_iterator() : block{nullptr}, index{0} {}
+        basic_iterator(const basic_iterator&) = default;
+        basic_iterator(basic_iterator&&) = default;
+        ~basic_iterator() = default;
+        basic_iterator& operator=(const basic_iterator&) = default;
+        basic_iterator& operator=(basic_iterator&&) = default;
+
+        basic_iterator(const Link* block, size_t index) noexcept : block{const_cast<Link*>(block)}, index{index} {}
+
+        // iterator converts to const_iterator, not the other way around
+        template <typename P, typename R, typename = typename std::enable_if<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>::type>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : block{other.block}, index{other.index} {}
+
+        reference operator*() const {
+            return _block(block)->data()[index];
+        }
+        pointer operator->() const {
+            return _block(block)->data() + index;
+        }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            if (++index == _block(block)->count) {
+                block = block->next;
+                index = 0;
+            }
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator hold = *this;
+            ++*this;
+            return hold;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            if (index == 0) {
+                block = block->prev;
+                index = _block(block)->count;
+            }
+            --index;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator hold = *this;
+            --*this;
+            return hold;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.block == rhs.block && lhs.index == rhs.index;
+        }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        template <typename P, typename R>
+        friend class basic_iterator;
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+    static constexpr size_type block_size = BlockSize;
+
+private:
+    Link head, tail;
+    size_type _size;
+
+    bool _is_block(const Link* link) const noexcept {
+        return link != &head && link != &tail;
+    }
+
+    // A new empty block linked in front of pos
+    Block* _new_block(Link* pos) {
+        Block* block = new Block();
+        block->next = pos;
+        block->prev = pos->prev;
+        pos->prev->next = block;
+        pos->prev = block;
+        return block;
+    }
+
+    void _free_block(Block* block) noexcept {
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        delete block;
+    }
+
+    // Moves the elements [from, block->count) of block to the end of into
+    static void _move_tail(Block* block, size_t from, Block* into) {
+        T* src = block->data();
+        T* dst = into->data();
+        for (size_t i = from; i < block->count; i++) {
+            new (dst + into->count) T(std::move(src[i]));
+            into->count++;
+        }
+        for (size_t i = from; i < block->count; i++) {
+            src[i].~T();
+        }
+        block->count = from;
+    }
+
+    // Puts value in slot index of a block that has room, shifting the
+    // elements after it one slot up
+    static void _place(Block* block, size_t index, T&& value) {
+        T* data = block->data();
+        if (index == block->count) {
+            new (data + index) T(std::move(value));
+            block->count++;
+        }
+        else {
+            new (data + block->count) T(std::move(data[block->count - 1]));
+            block->count++;
+            std::move_backward(data + index, data + block->count - 2, data + block->count - 1);
+            data[index] = std::move(value);
+        }
+    }
+
+    void _destroy_all() noexcept {
+        Link* link = head.next;
+        while (link != &tail) {
+            Block* block = _block(link);
+            link = link->next;
+            for (size_t i = 0; i < block->count; i++) {
+                block->data()[i].~T();
+            }
+            delete block;
+        }
+        head.next = &tail;
+        tail.prev = &head;
+        _size = 0;
+    }
+
+    void _append_all(const UnrolledList& other) {
+        for (const T& value : other) {
+            emplace_back(value);
+        }
+    }
+
+    void _take(UnrolledList& other) noexcept {
+        if (other.empty()) {
+            head.next = &tail;
+            tail.prev = &head;
+            _size = 0;
+            return;
+        }
+        head.next = other.head.next;
+        tail.prev = other.tail.prev;
+        head.next->prev = &head;
+        tail.prev->next = &tail;
+        _size = other._size;
+        other.head.next = &other.tail;
+        other.tail.prev = &other.head;
+        other._size = 0;
+    }
+
+public:
+    UnrolledList() : head(), tail(), _size(0) {
+        head.next = &tail;
+        tail.prev = &head;
+    }
+
+    UnrolledList(size_type count, const T& value) : UnrolledList() {
+        for (size_type i = 0; i < count; i++) {
+            emplace_back(value);
+        }
+    }
+
+    explicit UnrolledList(size_type count) : UnrolledList() {
+        for (size_type i = 0; i < count; i++) {
+            emplace_back();
+        }
+    }
+
+    UnrolledList( const UnrolledList& other ) : UnrolledList() {
+        _append_all(other);
+    }
+
+    UnrolledList( UnrolledList&& other ) noexcept : UnrolledList() {
+        _take(other);
+    }
+
+    ~UnrolledList() {
+        _destroy_all();
+    }
+
+    UnrolledList& operator=( const UnrolledList& other ) {
+        if (this != &other) {
+            clear();
+            _append_all(other);
+        }
+        return *this;
+    }
+
+    UnrolledList& operator=( UnrolledList&& other ) noexcept {
+        if (this != &other) {
+            clear();
+            _take(other);
+        }
+        return *this;
+    }
+
+    reference front() {
+        return *begin();
+    }
+    const_reference front() const {
+        return *cbegin();
+    }
+
+    reference back() {
+        return *--end();
+    }
+    const_reference back() const {
+        return *--cend();
+    }
+
+    iterator begin() noexcept {
+        return iterator(head.next, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head.next, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(head.next, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(&tail, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(&tail, 0);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(&tail, 0);
+    }
+
+    bool empty() const noexcept {
+        return (_size == 0);
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    // Number of blocks in use
+    size_type blocks() const noexcept {
+        size_type count = 0;
+        for (const Link* link = head.next; link != &tail; link = link->next) {
+            count++;
+        }
+        return count;
+    }
+
+    void clear() noexcept {
+        _destroy_all();
+    }
+
+    // Constructs the element in front of pos. The value is built before
+    // any element moves, so a throwing constructor changes nothing.
+    template <class... Args>
+    iterator emplace( const_iterator pos, Args&&... args ) {
+        T value(std::forward<Args>(args)...);
+
+        Link* link = pos.block;
+        size_t index = pos.index;
+        // the end or the front of a block also borders the block before
+        if (index == 0 && _is_block(link->prev) && _block(link->prev)->count < BlockSize) {
+            link = link->prev;
+            index = _block(link)->count;
+        }
+        else if (!_is_block(link)) {
+            link = _new_block(link);
+        }
+
+        Block* block = _block(link);
+        if (block->count == BlockSize) {
+            // split the upper half off into a new block after this one
+            Block* upper = _new_block(block->next);
+            _move_tail(block, BlockSize / 2, upper);
+            if (index > block->count) {
+                index -= block->count;
+                block = upper;
+            }
+        }
+
+        try {
+            _place(block, index, std::move(value));
+        }
+        catch (...) {
+            if (block->count == 0) {
+                _free_block(block);
+            }
+            throw;
+        }
+        _size += 1;
+        return iterator(block, index);
+    }
+
+    iterator insert( const_iterator pos, const T& value ) {
+        return emplace(pos, value);
+    }
+    iterator insert( const_iterator pos, T&& value ) {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator erase( const_iterator pos ) {
+        Block* block = _block(pos.block);
+        size_t index = pos.index;
+        T* data = block->data();
+        std::move(data + index + 1, data + block->count, data + index);
+        data[--block->count].~T();
+        _size -= 1;
+
+        if (block->count == 0) {
+            Link* next = block->next;
+            _free_block(block);
+            return iterator(next, 0);
+        }
+
+        // fold the next block in when both fit in one
+        Link* next = block->next;
+        if (block->count < BlockSize / 2 && _is_block(next) && block->count + _block(next)->count <= BlockSize) {
+            _move_tail(_block(next), 0, block);
+            _free_block(_block(next));
+        }
+
+        if (index == block->count) {
+            return iterator(block->next, 0);
+        }
+        return iterator(block, index);
+    }
+
+    template <class... Args>
+    reference emplace_back( Args&&... args ) {
+        return *emplace(cend(), std::forward<Args>(args)...);
+    }
+    void push_back( const T& value ) {
+        emplace_back(value);
+    }
+    void push_back( T&& value ) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        erase(--cend());
+    }
+
+    template <class... Args>
+    reference emplace_front( Args&&... args ) {
+        return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+    void push_front( const T& value ) {
+        emplace_front(value);
+    }
+    void push_front( T&& value ) {
+        emplace_front(std::move(value));
+    }
+
+    void pop_front() {
+        erase(cbegin());
+    }
+
+    iterator insert( iterator pos, const T & value) {
+        return insert(const_iterator(pos), value);
+    }
+    iterator insert( iterator pos, T && value ) {
+        return insert(const_iterator(pos), std::move(value));
+    }
+
+    iterator erase( iterator pos ) {
+        return erase(const_iterator(pos));
+    }
+};
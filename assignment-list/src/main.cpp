@@ -1,7 +1,19 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "List.h"
 #include "Card.h"
+#include "Simulation.h"
+
+// The tests supply their own seeded rand221; the program uses rand
+int rand221() {
+    return std::rand();
+}
 
 std::ostream& operator<< (std::ostream& out, const Suit& suit) {
     switch (suit) {
@@ -49,9 +61,46 @@ std::ostream& operator<< (std::ostream& out, const List<T>& list) {
     return out;
 }
 
+// Prints the throughput and how evenly suits and ranks were spread over
+// the positions of the deck
+void report(const SimulationStats& stats, const List<Card>& deck, size_t threads) {
+    const size_t cards = deck.size();
+    std::cout << stats.decks << " decks on " << threads << " threads in " << stats.seconds << "s: "
+              << std::fixed << std::setprecision(0) << stats.decksPerSecond() << " decks/s\n";
+    if (stats.decks == 0 || cards == 0) {
+        return;
+    }
+
+    // how often each suit and rank shows up in one deck
+    double suit_share[N_SUITS] = {};
+    double rank_share[N_RANKS] = {};
+    for (const Card& card : deck) {
+        suit_share[static_cast<size_t>(card.suit)] += 1.0 / cards;
+        rank_share[card.rank - 1] += 1.0 / cards;
+    }
+
+    std::cout << std::setprecision(2) << "\nposition  % spades  % diamonds  % clubs  % hearts\n";
+    double worst = 0;
+    for (size_t p = 0; p < cards; p++) {
+        std::cout << std::setw(8) << p + 1;
+        for (size_t s = 0; s < N_SUITS; s++) {
+            std::cout << std::setw(s == 1 ? 12 : s == 0 ? 10 : 9) << 100.0 * stats.suit_at[p][s] / stats.decks;
+        }
+        std::cout << '\n';
+        for (size_t r = 0; r < N_RANKS; r++) {
+            if (rank_share[r] > 0) {
+                double expected = stats.decks * rank_share[r];
+                worst = std::max(worst, std::fabs(stats.rank_at[p][r] - expected) / expected);
+            }
+        }
+    }
+    std::cout << "\nlargest deviation of a rank count from uniform: " << 100.0 * worst << "%\n";
+}
+
 int main(int argc, char* argv[]) {
     if (argc == 1) {
-        std::cout << "Usage: " << argv[0] << " <deck-file>\n\tDeck file is a formatted file containing Cards.\n\tsuit\trank\n\tsuit\trank\n\t...\t...\n\tIs the format.\n";
+        std::cout << "Usage: " << argv[0] << " <deck-file> [--simulate <decks> [threads] [seed]]\n\tDeck file is a formatted file containing Cards.\n\tsuit\trank\n\tsuit\trank\n\t...\t...\n\tIs the format.\n"
+                  << "\t--simulate shuffles and deals that many decks across threads (default one per core) and reports decks/s.\n";
         return 1;
     }
 
@@ -59,6 +108,17 @@ int main(int argc, char* argv[]) {
     
     List<Card> deck = buildDeck(deck_file);
 
+    if (argc > 3 && std::strcmp(argv[2], "--simulate") == 0) {
+        size_t decks = std::strtoull(argv[3], nullptr, 10);
+        size_t threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+        uint64_t seed = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 0x221;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        report(simulate(deck, decks, threads, seed), deck, threads);
+        return 0;
+    }
+
     std::cout << "Deck: " << deck << std::endl;
 
     List<Card> shuffled_deck = shuffle(deck);
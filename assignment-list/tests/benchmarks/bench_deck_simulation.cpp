@@ -0,0 +1,34 @@
+// Decks shuffled, dealt and tallied per second by simulate, for the full
+// deck at 1, 2, 4, ... threads. Speedups are bounded by the number of
+// cores, which is printed first.
+//
+// Usage: bench_deck_simulation [decks] [max threads]    (default 1,000,000 16)
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#include "Simulation.h"
+#include "deck.h"
+
+int main(int argc, char ** argv) {
+    size_t decks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+
+    std::stringstream ss(FULL_DECK);
+    List<Card> deck = buildDeck(ss);
+
+    std::printf("%zu decks, %u cores\n", decks, std::thread::hardware_concurrency());
+    std::printf("%8s %12s %8s\n", "threads", "decks/s", "speedup");
+
+    double base = 0;
+    for(size_t threads = 1; threads <= max_threads; threads *= 2) {
+        SimulationStats stats = simulate(deck, decks, threads);
+        if(threads == 1)
+            base = stats.decksPerSecond();
+        std::printf("%8zu %12.0f %8.2f\n", threads, stats.decksPerSecond(), stats.decksPerSecond() / base);
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+// UnrolledList<int> against List<int> and a pooled List<int> from 1K to
+// 10M elements. Times are nanoseconds per element:
+//   build    - push_back of every element
+//   iterate  - summing the list front to back
+//   sorted   - the same sum after List::sort has relinked the nodes out
+//              of allocation order, which is where one node per element
+//              hurts (an UnrolledList has no sort and is walked as is)
+//   insert   - one pass that inserts after every element
+//
+// Usage: bench_unrolled_list [max elements]    (default 10,000,000)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+#include "List.h"
+#include "NodePool.h"
+#include "UnrolledList.h"
+#include "xoshiro256.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Enough passes over small lists for the clock to see them
+static size_t reps_for(size_t n) {
+    return n >= 10000000 ? 1 : 10000000 / n;
+}
+
+static double ns_per(Clock::time_point start, size_t count) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+}
+
+template <typename L>
+static long long sum(const L & ll) {
+    long long total = 0;
+    for(auto it = ll.cbegin(); it != ll.cend(); ++it)
+        total += *it;
+    return total;
+}
+
+template <typename L>
+static double time_iterate(const L & ll, long long & sink) {
+    size_t reps = reps_for(ll.size());
+    auto start = Clock::now();
+    for(size_t r = 0; r < reps; r++)
+        sink += sum(ll);
+    return ns_per(start, reps * ll.size());
+}
+
+template <typename L>
+static void sort_if_list(L & ll) {
+    ll.sort();
+}
+template <typename T, size_t B>
+static void sort_if_list(UnrolledList<T, B> &) {}
+
+template <typename L>
+static void run(const char * name, size_t n, long long & sink) {
+    xoshiro256 rng(n);
+
+    auto start = Clock::now();
+    L * ll = new L();
+    for(size_t i = 0; i < n; i++)
+        ll->push_back(static_cast<int>(rng() % 1000));
+    double build = ns_per(start, n);
+
+    double iterate = time_iterate(*ll, sink);
+    sort_if_list(*ll);
+    double sorted = time_iterate(*ll, sink);
+
+    start = Clock::now();
+    for(auto it = ll->begin(); it != ll->end(); ) {
+        it = ll->insert(++it, 1);
+        ++it;
+    }
+    double insert = ns_per(start, n);
+
+    std::printf("%10zu %-18s %8.2f %8.2f %8.2f %8.2f\n", n, name, build, iterate, sorted, insert);
+    delete ll;
+}
+
+template <typename L>
+static void sweep(const char * name, size_t max_n, long long & sink) {
+    for(size_t n = 1000; n <= max_n; n *= 10)
+        run<L>(name, n, sink);
+}
+
+int main(int argc, char ** argv) {
+    size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    long long sink = 0;
+
+    std::printf("%10s %-18s %8s %8s %8s %8s\n", "elements", "container", "build", "iterate", "sorted", "insert");
+    sweep<UnrolledList<int, 16>>("UnrolledList<16>", max_n, sink);
+    sweep<UnrolledList<int, 64>>("UnrolledList<64>", max_n, sink);
+    sweep<List<int, NodePool<int>>>("List+NodePool", max_n, sink);
+    // last: millions of scattered small frees leave the heap in a state
+    // that slows down the larger allocations of the runs above
+    sweep<List<int>>("List", max_n, sink);
+
+    // keep the sums from being optimized away
+    if(sink == 42)
+        std::printf(" ");
+    return 0;
+}
@@ -49,7 +49,8 @@ TEST(constructor_default_inserted) {
             
             // Prevent additional, unneeded copies
             // Also ensure default constructor is called
-            ASSERT_EQ(2 * sz + 3, mh.n_allocs());
+            // The sentinels hold no Container
+            ASSERT_EQ(2 * sz + 1, mh.n_allocs());
 
             for(auto it = ll->cbegin(); it != ll->cend(); it++) {
                 ASSERT_EQ(4, *(*it).box);
@@ -58,7 +59,7 @@ TEST(constructor_default_inserted) {
             delete ll;
 
             // Ensure memory is freed
-            ASSERT_EQ(2 * sz + 3, mh.n_frees());
+            ASSERT_EQ(2 * sz + 1, mh.n_frees());
         }
     }
 }
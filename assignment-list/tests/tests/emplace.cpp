@@ -0,0 +1,124 @@
+#include "executable.h"
+#include "box.h"
+
+#include <iterator>
+#include <list>
+#include <vector>
+
+// Not default constructible, and counts how it was made
+struct Tracked {
+    static size_t constructed, copied, moved;
+
+    int a, b;
+
+    Tracked(int a, int b) : a{a}, b{b} { constructed++; }
+    Tracked(const Tracked & other) : a{other.a}, b{other.b} { copied++; }
+    Tracked(Tracked && other) : a{other.a}, b{other.b} { moved++; }
+
+    static void reset() {
+        constructed = copied = moved = 0;
+    }
+};
+size_t Tracked::constructed = 0;
+size_t Tracked::copied = 0;
+size_t Tracked::moved = 0;
+
+TEST(emplace_sentinels) {
+    // an empty list has no elements to construct
+    Tracked::reset();
+    {
+        List<Tracked> ll;
+        ASSERT_TRUE(ll.cbegin() == ll.cend());
+    }
+    ASSERT_EQ(0ULL, Tracked::constructed);
+
+    {
+        Memhook mh;
+        List<Box<int>> * ll = new List<Box<int>>();
+        delete ll;
+
+        // only the list itself, no boxes for the sentinels
+        ASSERT_EQ(1ULL, mh.n_allocs());
+    }
+}
+
+TEST(emplace) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        List<Tracked> ll;
+        std::list<std::pair<int, int>> gt;
+
+        Tracked::reset();
+        for(size_t k = 0; k < n; k++) {
+            int a = t.get<int>();
+            int b = t.get<int>();
+
+            switch(t.range(3ULL)) {
+                case 0: {
+                    Tracked & ref = ll.emplace_back(a, b);
+                    ASSERT_TRUE(&ref == &ll.back());
+                    gt.emplace_back(a, b);
+                    break;
+                }
+                case 1: {
+                    Tracked & ref = ll.emplace_front(a, b);
+                    ASSERT_TRUE(&ref == &ll.front());
+                    gt.emplace_front(a, b);
+                    break;
+                }
+                default: {
+                    size_t at = t.range(gt.size() + 1);
+                    auto it = ll.emplace(std::next(ll.cbegin(), at), a, b);
+                    ASSERT_EQ(a, it->a);
+                    gt.emplace(std::next(gt.cbegin(), at), a, b);
+                }
+            }
+        }
+
+        // every element was built once, in its node
+        ASSERT_EQ(n, Tracked::constructed);
+        ASSERT_EQ(0ULL, Tracked::copied);
+        ASSERT_EQ(0ULL, Tracked::moved);
+        ASSERT_EQ(n, ll.size());
+
+        auto it = ll.cbegin();
+        for(auto const & p : gt) {
+            ASSERT_EQ(p.first, it->a);
+            ASSERT_EQ(p.second, it->b);
+            it++;
+        }
+        for(auto gt_it = gt.crbegin(); gt_it != gt.crend(); gt_it++)
+            ASSERT_EQ(gt_it->first, (--it)->a);
+    }
+}
+
+TEST(emplace_allocations) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        List<Box<int>> * ll = new List<Box<int>>();
+        {
+            Memhook mh;
+
+            for(size_t k = 0; k < n; k++)
+                ll->emplace_back(gt[k]);
+
+            // one node and one box per element
+            ASSERT_EQ(2 * n, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+
+        auto it = ll->cbegin();
+        for(size_t k = 0; k < n; k++, it++)
+            ASSERT_EQ(gt[k], **it);
+
+        delete ll;
+    }
+}
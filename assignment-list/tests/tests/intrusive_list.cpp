@@ -0,0 +1,158 @@
+#include "executable.h"
+
+#include "IntrusiveList.h"
+
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+// Sits in a queue and in its owner's list at the same time
+struct Task {
+    int id;
+    ListHook in_queue;
+    ListHook in_owner;
+
+    explicit Task(int id) : id{id} {}
+};
+
+using Queue = IntrusiveList<Task, &Task::in_queue>;
+using Owned = IntrusiveList<Task, &Task::in_owner>;
+
+template <typename L>
+static bool matches(const std::list<int> & gt, const L & ll) {
+    if(gt.size() != ll.size())
+        return false;
+
+    auto it = ll.cbegin();
+    for(int id : gt)
+        if(id != (it++)->id)
+            return false;
+    for(auto gt_it = gt.crbegin(); gt_it != gt.crend(); gt_it++)
+        if(*gt_it != (--it)->id)
+            return false;
+    return it == ll.cbegin();
+}
+
+TEST(intrusive_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x99ULL);
+        std::vector<Task> tasks;
+        tasks.reserve(n);
+        for(size_t k = 0; k < n; k++)
+            tasks.emplace_back(static_cast<int>(k));
+
+        Queue queue;
+        Owned even, odd;
+        std::list<int> gt_queue, gt_even, gt_odd;
+
+        for(Task & task : tasks) {
+            if(t.range(2ULL) == 0) {
+                queue.push_back(task);
+                gt_queue.push_back(task.id);
+            }
+            else {
+                queue.push_front(task);
+                gt_queue.push_front(task.id);
+            }
+            (task.id % 2 ? odd : even).push_back(task);
+            (task.id % 2 ? gt_odd : gt_even).push_back(task.id);
+        }
+
+        // a task leaves the queue through its hook, staying with its owner
+        for(size_t k = t.range(n); k > 0; k--) {
+            Task & task = tasks[t.range(n)];
+            if(!task.in_queue.linked())
+                continue;
+            task.in_queue.unlink();
+            gt_queue.remove(task.id);
+        }
+
+        // or through erase at its position
+        if(!queue.empty()) {
+            Task & task = queue.front();
+            auto next = queue.erase(queue.iterator_to(task));
+            gt_queue.pop_front();
+            ASSERT_TRUE(next == queue.begin());
+            ASSERT_FALSE(task.in_queue.linked());
+            ASSERT_TRUE(task.in_owner.linked());
+        }
+
+        // odd owners hand everything over to even ones
+        even.splice(even.cbegin(), odd);
+        gt_even.splice(gt_even.cbegin(), gt_odd);
+
+        ASSERT_TRUE(matches(gt_queue, queue));
+        ASSERT_TRUE(matches(gt_even, even));
+        ASSERT_TRUE(odd.empty());
+    }
+}
+
+TEST(intrusive_list_no_allocations) {
+    std::vector<Task> tasks;
+    for(int k = 0; k < 100; k++)
+        tasks.emplace_back(k);
+
+    Queue a, b;
+    Memhook mh;
+
+    for(Task & task : tasks)
+        a.push_back(task);
+    b.splice(b.cend(), a, std::next(a.cbegin(), 10), std::next(a.cbegin(), 60));
+    b.splice(b.cbegin(), a, a.cbegin());
+    a.erase(a.cbegin());
+    b.pop_back();
+    a.clear();
+
+    ASSERT_EQ(0ULL, mh.n_allocs());
+    ASSERT_EQ(0ULL, mh.n_frees());
+    ASSERT_EQ(50ULL, b.size());
+    ASSERT_EQ(0, b.front().id);
+    ASSERT_EQ(58, b.back().id);
+}
+
+TEST(intrusive_list_lifetime) {
+    Queue queue;
+    {
+        Task a(1), b(2), c(3);
+        queue.push_back(a);
+        queue.push_back(b);
+        queue.push_back(c);
+
+        // a linked object can not join a second list through the same hook
+        Queue other;
+        bool thrown = false;
+        try {
+            other.push_back(b);
+        }
+        catch(const std::invalid_argument &) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        // a copy is in no list
+        Task copy = b;
+        ASSERT_FALSE(copy.in_queue.linked());
+        ASSERT_EQ(3ULL, queue.size());
+
+        {
+            Task d(4);
+            queue.insert(queue.iterator_to(b), d);
+            ASSERT_EQ(4, std::next(queue.begin())->id);
+        }
+        // d unlinked itself when it went away
+        ASSERT_EQ(3ULL, queue.size());
+        ASSERT_EQ(2, std::next(queue.begin())->id);
+
+        // moving the list takes the objects along
+        Queue moved(std::move(queue));
+        ASSERT_TRUE(queue.empty());
+        ASSERT_EQ(1, moved.front().id);
+        ASSERT_EQ(3, moved.back().id);
+        queue = std::move(moved);
+    }
+    // and so did the rest
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,86 @@
+#include "executable.h"
+#include "box.h"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <utility>
+#include <vector>
+
+TEST(merge) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        // few distinct keys so ties are common; the second value records
+        // where each element came from to check stability
+        std::vector<std::pair<int, int>> va(t.range(0x199ULL)), vb(t.range(0x199ULL));
+        for(size_t k = 0; k < va.size(); k++)
+            va[k] = {t.range(0, 20), static_cast<int>(k)};
+        for(size_t k = 0; k < vb.size(); k++)
+            vb[k] = {t.range(0, 20), static_cast<int>(k) + 0x10000};
+
+        auto by_key = [](const std::pair<int, int> & x, const std::pair<int, int> & y) { return x.first < y.first; };
+        std::stable_sort(va.begin(), va.end(), by_key);
+        std::stable_sort(vb.begin(), vb.end(), by_key);
+
+        List<std::pair<int, int>> a, b;
+        std::list<std::pair<int, int>> gt_a(va.begin(), va.end()), gt_b(vb.begin(), vb.end());
+        for(auto & p : va)
+            a.push_back(p);
+        for(auto & p : vb)
+            b.push_back(p);
+
+        {
+            Memhook mh;
+            a.merge(b, by_key);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+        gt_a.merge(gt_b, by_key);
+
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(gt_a.size(), a.size());
+
+        auto it = a.cbegin();
+        for(auto & p : gt_a) {
+            ASSERT_EQ(p.first, it->first);
+            ASSERT_EQ(p.second, it->second);
+            it++;
+        }
+        for(auto gt_it = gt_a.crbegin(); gt_it != gt_a.crend(); gt_it++)
+            ASSERT_EQ((--it)->second, gt_it->second);
+    }
+}
+
+TEST(merge_default_order) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::vector<int> va(t.range(0x199ULL)), vb(t.range(0x199ULL));
+        t.fill(va.begin(), va.end());
+        t.fill(vb.begin(), vb.end());
+        std::sort(va.begin(), va.end());
+        std::sort(vb.begin(), vb.end());
+
+        List<Box<int>> a, b;
+        for(int v : va)
+            a.push_back(v);
+        for(int v : vb)
+            b.push_back(v);
+
+        std::vector<int> gt(va.size() + vb.size());
+        std::merge(va.begin(), va.end(), vb.begin(), vb.end(), gt.begin());
+
+        {
+            Memhook mh;
+            // Box has no operator<, so compare the boxed values
+            a.merge(std::move(b), [](const Box<int> & x, const Box<int> & y) { return *x < *y; });
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+
+        ASSERT_EQ(gt.size(), a.size());
+        auto it = a.cbegin();
+        for(int v : gt)
+            ASSERT_EQ(v, **it++);
+    }
+}
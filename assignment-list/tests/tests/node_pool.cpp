@@ -0,0 +1,206 @@
+#include "executable.h"
+#include "box.h"
+
+#include "NodePool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+constexpr size_t SLAB = 64;
+
+template <typename T>
+using PooledList = List<T, NodePool<T, SLAB>>;
+
+static size_t slabs_for(size_t n) {
+    return (n + SLAB - 1) / SLAB;
+}
+
+TEST(node_pool) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        PooledList<int> * ll = new PooledList<int>();
+
+        {
+            Memhook mh;
+
+            for(size_t i = 0; i < n; i++)
+                ll->push_back(gt[i]);
+
+            // one allocation per slab, not per node
+            ASSERT_EQ(slabs_for(n), mh.n_allocs());
+            ASSERT_EQ(n, ll->size());
+        }
+
+        // freed nodes are reused before any new slab
+        size_t k = t.range(n + 1);
+        {
+            Memhook mh;
+
+            for(size_t i = 0; i < k; i++)
+                ll->pop_front();
+            for(size_t i = 0; i < k; i++)
+                ll->push_back(gt[i]);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(n, ll->size());
+        }
+
+        // the first k values rotated to the back
+        auto it = ll->cbegin();
+        for(size_t j = 0; j < n; j++, it++)
+            ASSERT_EQ(gt[(j + k) % n], *it);
+
+        {
+            Memhook mh;
+
+            // the slabs go back whole
+            ll->clear();
+
+            ASSERT_EQ(slabs_for(n), mh.n_frees());
+            ASSERT_TRUE(ll->empty());
+        }
+
+        delete ll;
+    }
+}
+
+TEST(node_pool_destructors) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        PooledList<Box<int>> * ll = new PooledList<Box<int>>();
+        for(size_t i = 0; i < n; i++)
+            ll->push_back(gt[i]);
+
+        auto it = ll->cbegin();
+        for(size_t j = 0; j < n; j++, it++)
+            ASSERT_EQ(gt[j], **it);
+
+        {
+            Memhook mh;
+
+            ll->clear();
+
+            // every box and every slab
+            ASSERT_EQ(n + slabs_for(n), mh.n_frees());
+        }
+
+        delete ll;
+    }
+}
+
+TEST(node_pool_copy_and_move) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+
+        const size_t n = t.range(1ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        PooledList<int> a;
+        for(size_t i = 0; i < n; i++)
+            a.push_back(gt[i]);
+
+        // a copy fills a pool of its own
+        PooledList<int> b(a);
+        a.clear();
+        ASSERT_EQ(n, b.size());
+
+        {
+            Memhook mh;
+
+            // the nodes and their pool move together
+            PooledList<int> c(std::move(b));
+            a = std::move(c);
+
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+
+        ASSERT_EQ(n, a.size());
+        ASSERT_TRUE(b.empty());
+
+        size_t j = 0;
+        for(int value : a)
+            ASSERT_EQ(gt[j++], value);
+
+        // the moved from list still works with a fresh pool
+        b.push_back(1);
+        ASSERT_EQ(1, b.front());
+    }
+}
+
+TEST(node_pool_splice_and_merge) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+
+        const size_t n = t.range(1ULL, 0x99ULL);
+        const size_t m = t.range(1ULL, 0x99ULL);
+        std::vector<int> gt_a(n), gt_b(m);
+        t.fill(gt_a.begin(), gt_a.end());
+        t.fill(gt_b.begin(), gt_b.end());
+
+        PooledList<int> a, b;
+        for(int value : gt_a)
+            a.push_back(value);
+        for(int value : gt_b)
+            b.push_back(value);
+
+        // within one list the nodes are only relinked
+        {
+            Memhook mh;
+
+            a.splice(a.cbegin(), a, std::prev(a.cend()));
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(gt_a.back(), a.front());
+            a.splice(a.cend(), a, a.cbegin());
+        }
+
+        // each pool can only free its own slots, so the elements of b are
+        // moved into nodes from a's pool and b's nodes go back to b's
+        const int * first_of_b = &b.front();
+        a.splice(a.cend(), b);
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(n + m, a.size());
+        ASSERT_TRUE(&*std::next(a.cbegin(), n) != first_of_b);
+
+        auto it = a.cbegin();
+        for(size_t j = 0; j < n; j++, it++)
+            ASSERT_EQ(gt_a[j], *it);
+        for(size_t j = 0; j < m; j++, it++)
+            ASSERT_EQ(gt_b[j], *it);
+
+        // merge goes the same way, one element at a time
+        std::vector<int> gt(gt_a);
+        gt.insert(gt.end(), gt_b.begin(), gt_b.end());
+        std::sort(gt_a.begin(), gt_a.end());
+        std::sort(gt_b.begin(), gt_b.end());
+        std::sort(gt.begin(), gt.end());
+
+        PooledList<int> c, d;
+        for(int value : gt_a)
+            c.push_back(value);
+        for(int value : gt_b)
+            d.push_back(value);
+        c.merge(d);
+        ASSERT_TRUE(d.empty());
+        ASSERT_EQ(gt.size(), c.size());
+
+        size_t j = 0;
+        for(int value : c)
+            ASSERT_EQ(gt[j++], value);
+    }
+}
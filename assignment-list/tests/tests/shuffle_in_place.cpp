@@ -0,0 +1,117 @@
+#include "executable.h"
+#include "Card.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+static bool same_card(const Card & a, const Card & b) {
+    return a.suit == b.suit && a.rank == b.rank;
+}
+
+static std::vector<const Card *> addresses(const List<Card> & deck) {
+    std::vector<const Card *> out;
+    for(const Card & card : deck)
+        out.push_back(&card);
+    return out;
+}
+
+TEST(shuffle_in_place) {
+    std::stringstream ss(FULL_DECK);
+    const List<Card> ordered = buildDeck(ss);
+
+    List<Card> deck = ordered;
+    DeckRng rng(0x221);
+
+    // the first call sets up the scratch space
+    shuffle(deck, rng);
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::vector<const Card *> before = addresses(deck);
+        {
+            Memhook mh;
+            shuffle(deck, rng);
+
+            // the same nodes, relinked
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+        std::vector<const Card *> after = addresses(deck);
+        ASSERT_EQ(ordered.size(), deck.size());
+        std::sort(before.begin(), before.end());
+        std::sort(after.begin(), after.end());
+        ASSERT_TRUE(before == after);
+
+        // every card once
+        for(const Card & card : ordered)
+            ASSERT_EQ(1, std::count_if(deck.cbegin(), deck.cend(), [&](const Card & c) { return same_card(c, card); }));
+
+        // walking back agrees with walking forward
+        std::vector<const Card *> forward = addresses(deck);
+        auto it = deck.cend();
+        for(auto f = forward.rbegin(); f != forward.rend(); f++)
+            ASSERT_TRUE(*f == &*--it);
+    }
+}
+
+TEST(shuffle_in_place_reproducible) {
+    std::stringstream ss(FULL_DECK);
+    const List<Card> ordered = buildDeck(ss);
+
+    List<Card> a = ordered;
+    List<Card> b = ordered;
+    DeckRng rng_a(42);
+    DeckRng rng_b(42);
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        shuffle(a, rng_a);
+        shuffle(b, rng_b);
+        ASSERT_TRUE(std::equal(a.cbegin(), a.cend(), b.cbegin(), same_card));
+    }
+
+    // a jumped generator deals a different sequence
+    DeckRng rng_c(42);
+    rng_c.jump();
+    List<Card> c = ordered;
+    shuffle(c, rng_c);
+    List<Card> d = ordered;
+    DeckRng rng_d(42);
+    shuffle(d, rng_d);
+    ASSERT_FALSE(std::equal(c.cbegin(), c.cend(), d.cbegin(), same_card));
+}
+
+TEST(shuffle_in_place_uniform) {
+    // every one of the 24 orders of four cards shows up equally often
+    size_t constexpr CARDS = 4;
+    size_t constexpr ORDERS = 24;
+    size_t constexpr ROUNDS = 24000;
+
+    List<Card> deck;
+    for(size_t i = 0; i < CARDS; i++)
+        deck.push_back(Card{Suit::SPADES, static_cast<Rank>(i + 1)});
+
+    DeckRng rng(7);
+    std::vector<size_t> seen(ORDERS);
+    for(size_t i = 0; i < ROUNDS; i++) {
+        shuffle(deck, rng);
+
+        // the Lehmer code of the order
+        std::vector<Rank> ranks;
+        for(const Card & card : deck)
+            ranks.push_back(card.rank);
+        size_t code = 0;
+        for(size_t j = 0; j < CARDS; j++) {
+            size_t smaller = 0;
+            for(size_t k = j + 1; k < CARDS; k++)
+                smaller += ranks[k] < ranks[j];
+            code = code * (CARDS - j) + smaller;
+        }
+        seen[code]++;
+    }
+
+    // chi-squared with 23 degrees of freedom, far beyond p = 0.001
+    double chi = 0;
+    double expected = static_cast<double>(ROUNDS) / ORDERS;
+    for(size_t count : seen)
+        chi += (count - expected) * (count - expected) / expected;
+    ASSERT_LT(chi, 60.0);
+}
@@ -0,0 +1,82 @@
+#include "executable.h"
+#include "Card.h"
+#include "Simulation.h"
+
+#include <sstream>
+#include <stdexcept>
+
+TEST(packed_card) {
+    for(size_t s = 0; s < N_SUITS; s++) {
+        for(Rank r = ACE; r <= KING; r++) {
+            Card card{static_cast<Suit>(s), r};
+            PackedCard packed(card);
+            ASSERT_TRUE(packed.suit() == card.suit);
+            ASSERT_EQ(card.rank, packed.rank());
+            ASSERT_TRUE(packed.unpack().suit == card.suit);
+            ASSERT_EQ(card.rank, packed.unpack().rank);
+        }
+    }
+}
+
+TEST(simulate) {
+    std::stringstream ss(FULL_DECK);
+    const List<Card> deck = buildDeck(ss);
+    const size_t cards = deck.size();
+
+    for(size_t threads : {1UL, 3UL, 8UL}) {
+        const size_t decks = 5000 + threads;
+        SimulationStats stats = simulate(deck, decks, threads, 7);
+
+        ASSERT_EQ(decks, stats.decks);
+        ASSERT_EQ(cards, stats.rank_at.size());
+        ASSERT_EQ(cards, stats.suit_at.size());
+
+        // every deck dealt one card at every position
+        for(size_t p = 0; p < cards; p++) {
+            uint64_t ranks = 0, suits = 0;
+            for(uint64_t count : stats.rank_at[p])
+                ranks += count;
+            for(uint64_t count : stats.suit_at[p])
+                suits += count;
+            ASSERT_EQ(decks, ranks);
+            ASSERT_EQ(decks, suits);
+        }
+
+        // and every card somewhere in every deck
+        for(size_t r = 0; r < N_RANKS; r++) {
+            uint64_t total = 0;
+            for(size_t p = 0; p < cards; p++)
+                total += stats.rank_at[p][r];
+            ASSERT_EQ(4 * decks, total);
+        }
+
+        // roughly a quarter of each suit at each position
+        for(size_t p = 0; p < cards; p++)
+            for(uint64_t count : stats.suit_at[p])
+                ASSERT_TRUE(count > decks / 5 && count < decks * 3 / 10);
+
+        // the same seed and threads deal the same decks
+        SimulationStats again = simulate(deck, decks, threads, 7);
+        ASSERT_TRUE(stats.rank_at == again.rank_at);
+        ASSERT_TRUE(stats.suit_at == again.suit_at);
+    }
+}
+
+TEST(simulate_bad_rank) {
+    List<Card> deck;
+    deck.push_back(Card{Suit::SPADES, ACE});
+    deck.push_back(Card{Suit::SPADES, 14});
+
+    bool thrown = false;
+    try {
+        simulate(deck, 10, 2);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    // nothing to deal
+    ASSERT_EQ(0ULL, simulate(List<Card>(), 10, 2).rank_at.size());
+    ASSERT_EQ(0ULL, simulate(List<Card>(), 0, 2).decks);
+}
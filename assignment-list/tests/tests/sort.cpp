@@ -0,0 +1,124 @@
+#include "executable.h"
+#include "box.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TEST(sort) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+
+        // few distinct keys, the second value is the original position
+        std::vector<std::pair<int, int>> gt(n);
+        for(size_t k = 0; k < n; k++)
+            gt[k] = {t.range(0, 50), static_cast<int>(k)};
+
+        List<std::pair<int, int>> ll;
+        for(auto & p : gt)
+            ll.push_back(p);
+
+        std::vector<const void *> before;
+        for(auto & p : ll)
+            before.push_back(&p);
+
+        auto by_key = [](const std::pair<int, int> & x, const std::pair<int, int> & y) { return x.first < y.first; };
+        {
+            Memhook mh;
+            ll.sort(by_key);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+        std::stable_sort(gt.begin(), gt.end(), by_key);
+
+        ASSERT_EQ(n, ll.size());
+        auto it = ll.cbegin();
+        for(auto & p : gt) {
+            ASSERT_EQ(p.first, it->first);
+            ASSERT_EQ(p.second, it->second);
+            // each element stays in its node
+            ASSERT_TRUE(before[p.second] == &*it);
+            it++;
+        }
+        for(auto gt_it = gt.crbegin(); gt_it != gt.crend(); gt_it++)
+            ASSERT_EQ((--it)->second, gt_it->second);
+    }
+}
+
+TEST(sort_heavy_elements) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        List<Box<int>> ll;
+        for(int v : gt)
+            ll.push_back(v);
+
+        {
+            Memhook mh;
+            // no Box is copied or moved
+            ll.sort([](const Box<int> & x, const Box<int> & y) { return *x > *y; });
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+        std::sort(gt.begin(), gt.end(), std::greater<int>());
+
+        auto it = ll.cbegin();
+        for(int v : gt)
+            ASSERT_EQ(v, **it++);
+    }
+
+    List<int> ll;
+    for(int v : {3, 1, 2})
+        ll.push_back(v);
+    ll.sort();
+    ASSERT_EQ(1, ll.front());
+    ASSERT_EQ(3, ll.back());
+}
+
+TEST(sort_throwing_compare) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(2ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        List<int> ll;
+        for(int v : gt)
+            ll.push_back(v);
+
+        size_t calls = t.range(n);
+        bool thrown = false;
+        try {
+            ll.sort([&calls](int x, int y) {
+                if(calls-- == 0)
+                    throw std::runtime_error("compare");
+                return x < y;
+            });
+        }
+        catch(const std::runtime_error &) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        // every element is still there and the links are intact
+        ASSERT_EQ(n, ll.size());
+        std::vector<int> forward, backward;
+        for(auto it = ll.cbegin(); it != ll.cend(); it++)
+            forward.push_back(*it);
+        for(auto it = ll.cend(); it != ll.cbegin();)
+            backward.push_back(*--it);
+        std::reverse(backward.begin(), backward.end());
+        ASSERT_TRUE(forward == backward);
+        std::sort(forward.begin(), forward.end());
+        std::sort(gt.begin(), gt.end());
+        ASSERT_TRUE(forward == gt);
+    }
+}
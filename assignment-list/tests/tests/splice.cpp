@@ -0,0 +1,126 @@
+#include "executable.h"
+#include "box.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
+
+// Addresses of the elements, which must not change when nodes are relinked
+template <typename L>
+static std::vector<const void *> addresses(const L & ll) {
+    std::vector<const void *> out;
+    for(auto it = ll.cbegin(); it != ll.cend(); it++)
+        out.push_back(&*it);
+    return out;
+}
+
+TEST(splice) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        List<int> a, b;
+        std::list<int> gt_a, gt_b;
+
+        for(size_t k = t.range(0x99ULL); k > 0; k--) {
+            int value = t.get<int>();
+            a.push_back(value);
+            gt_a.push_back(value);
+        }
+        for(size_t k = t.range(0x99ULL); k > 0; k--) {
+            int value = t.get<int>();
+            b.push_back(value);
+            gt_b.push_back(value);
+        }
+
+        size_t at = t.range(gt_a.size() + 1);
+        size_t from = t.range(gt_b.size() + 1);
+        size_t to = from + t.range(gt_b.size() - from + 1);
+
+        auto pos = std::next(a.cbegin(), at);
+        auto first = std::next(b.cbegin(), from);
+        auto last = std::next(b.cbegin(), to);
+
+        {
+            Memhook mh;
+
+            switch(i % 3) {
+                case 0:
+                    a.splice(pos, b);
+                    gt_a.splice(std::next(gt_a.cbegin(), at), gt_b);
+                    break;
+                case 1:
+                    if(first == b.cend())
+                        break;
+                    a.splice(pos, b, first);
+                    gt_a.splice(std::next(gt_a.cbegin(), at), gt_b, std::next(gt_b.cbegin(), from));
+                    break;
+                default:
+                    a.splice(pos, b, first, last);
+                    gt_a.splice(std::next(gt_a.cbegin(), at), gt_b, std::next(gt_b.cbegin(), from), std::next(gt_b.cbegin(), to));
+            }
+
+            // nodes are relinked, never reallocated
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+
+        ASSERT_EQ(gt_a.size(), a.size());
+        ASSERT_EQ(gt_b.size(), b.size());
+
+        auto gt_it = gt_a.cbegin();
+        auto it = a.cbegin();
+        while(gt_it != gt_a.cend())
+            ASSERT_EQ_(*gt_it++, *it++, "An inconsistency was found when iterating forward");
+        while(gt_it != gt_a.cbegin())
+            ASSERT_EQ_(*--gt_it, *--it, "An inconsistency was found when iterating backward");
+
+        gt_it = gt_b.cbegin();
+        it = b.cbegin();
+        while(gt_it != gt_b.cend())
+            ASSERT_EQ(*gt_it++, *it++);
+        while(gt_it != gt_b.cbegin())
+            ASSERT_EQ(*--gt_it, *--it);
+    }
+}
+
+TEST(splice_same_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x99ULL);
+        List<Box<int>> ll;
+        std::list<int> gt;
+        for(size_t k = 0; k < n; k++) {
+            int value = t.get<int>();
+            ll.push_back(value);
+            gt.push_back(value);
+        }
+
+        // a range and a position outside of it
+        size_t from = t.range(n);
+        size_t to = from + t.range(n - from + 1);
+        size_t at = t.range(n - (to - from) + 1);
+        if(at >= from)
+            at += to - from;
+
+        std::vector<const void *> before = addresses(ll);
+        {
+            Memhook mh;
+            ll.splice(std::next(ll.cbegin(), at), ll, std::next(ll.cbegin(), from), std::next(ll.cbegin(), to));
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+        gt.splice(std::next(gt.cbegin(), at), gt, std::next(gt.cbegin(), from), std::next(gt.cbegin(), to));
+
+        ASSERT_EQ(n, ll.size());
+        auto it = ll.cbegin();
+        for(int value : gt)
+            ASSERT_EQ(value, **it++);
+
+        // the same nodes, only in a different order
+        std::vector<const void *> after = addresses(ll);
+        std::sort(before.begin(), before.end());
+        std::sort(after.begin(), after.end());
+        ASSERT_TRUE(before == after);
+    }
+}
@@ -0,0 +1,159 @@
+#include "executable.h"
+#include "box.h"
+
+#include "UnrolledList.h"
+
+#include <iterator>
+#include <list>
+#include <vector>
+
+constexpr size_t BLOCK = 8;
+
+template <typename T>
+using Unrolled = UnrolledList<T, BLOCK>;
+
+// Same elements in the same order, walking both ways
+template <typename L>
+static bool matches(const std::list<int> & gt, const L & ll) {
+    if(gt.size() != ll.size())
+        return false;
+
+    auto it = ll.cbegin();
+    for(int value : gt)
+        if(value != *it++)
+            return false;
+    if(it != ll.cend())
+        return false;
+
+    for(auto gt_it = gt.crbegin(); gt_it != gt.crend(); gt_it++)
+        if(*gt_it != *--it)
+            return false;
+    return it == ll.cbegin();
+}
+
+TEST(unrolled_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        Unrolled<int> ll;
+        std::list<int> gt;
+
+        for(size_t op = t.range(0x999ULL); op > 0; op--) {
+            int value = t.get<int>();
+
+            switch(t.range(6ULL)) {
+                case 0:
+                    ll.push_back(value);
+                    gt.push_back(value);
+                    break;
+                case 1:
+                    ll.push_front(value);
+                    gt.push_front(value);
+                    break;
+                case 2:
+                case 3: {
+                    size_t at = t.range(gt.size() + 1);
+                    auto it = ll.insert(std::next(ll.cbegin(), at), value);
+                    gt.insert(std::next(gt.cbegin(), at), value);
+                    ASSERT_EQ(value, *it);
+                    ASSERT_TRUE(it == std::next(ll.begin(), at));
+                    break;
+                }
+                default: {
+                    if(gt.empty())
+                        break;
+                    size_t at = t.range(gt.size());
+                    auto it = ll.erase(std::next(ll.cbegin(), at));
+                    auto gt_it = gt.erase(std::next(gt.cbegin(), at));
+                    // erase returns the position after
+                    ASSERT_TRUE(it == std::next(ll.begin(), at));
+                    if(gt_it != gt.end())
+                        ASSERT_EQ(*gt_it, *it);
+                }
+            }
+        }
+
+        ASSERT_TRUE(matches(gt, ll));
+
+        // no block is ever left empty
+        ASSERT_TRUE(ll.blocks() <= ll.size());
+    }
+}
+
+TEST(unrolled_list_blocks) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        Unrolled<int> ll;
+        Memhook mh;
+
+        for(size_t k = 0; k < n; k++)
+            ll.push_back(gt[k]);
+
+        // appending fills every block before starting the next
+        size_t full = (n + BLOCK - 1) / BLOCK;
+        ASSERT_EQ(full, ll.blocks());
+        ASSERT_EQ(full, mh.n_allocs());
+
+        // draining from the front gives the blocks back one by one
+        for(size_t k = 0; k < n; k++) {
+            ASSERT_EQ(gt[k], ll.front());
+            ASSERT_EQ(gt[n - 1], ll.back());
+            ll.pop_front();
+        }
+        ASSERT_EQ(0ULL, ll.blocks());
+        ASSERT_EQ(full, mh.n_frees());
+    }
+}
+
+TEST(unrolled_list_copy_and_move) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(0x999ULL);
+        std::list<int> gt;
+
+        Unrolled<Box<int>> * ll = new Unrolled<Box<int>>();
+        for(size_t k = 0; k < n; k++) {
+            int value = t.get<int>();
+            ll->emplace(std::next(ll->cbegin(), t.range(k + 1)), value);
+            gt.push_back(0);
+        }
+
+        Unrolled<Box<int>> copy(*ll);
+        ASSERT_EQ(n, copy.size());
+        auto a = ll->cbegin();
+        for(auto b = copy.cbegin(); b != copy.cend(); b++, a++)
+            ASSERT_EQ(**a, **b);
+
+        {
+            Memhook mh;
+
+            Unrolled<Box<int>> moved(std::move(copy));
+            copy = std::move(moved);
+
+            // the blocks change hands
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+            ASSERT_TRUE(moved.empty());
+        }
+        ASSERT_EQ(n, copy.size());
+
+        {
+            Memhook mh;
+
+            size_t blocks = ll->blocks();
+            delete ll;
+
+            // every box, every block and the list
+            ASSERT_EQ(n + blocks + 1, mh.n_frees());
+        }
+
+        Unrolled<int> zeros(n);
+        ASSERT_TRUE(matches(gt, zeros));
+    }
+}
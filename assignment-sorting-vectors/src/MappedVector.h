@@ -0,0 +1,169 @@
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cerrno> // errno
+#include <cstddef> // size_t
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <string> // std::string
+#include <system_error> // std::system_error
+#include <type_traits> // std::is_trivially_copyable
+
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+
+// A view of a binary file of fixed-size T records, mapped straight into
+// memory instead of being parsed into a container. Sorts and scans run
+// over the file contents directly and pages are only read in when they
+// are touched. POSIX only, as it is built on mmap.
+//
+// Iterator is what begin and end return, built from a T*. It defaults to
+// T* itself; a container's own iterator, such as Vector<T>::iterator,
+// lets the view go wherever that container's iterators do.
+//
+// The mapping is private: writes, such as sorting in place, stay in this
+// process and never reach the file. The records must be in the layout
+// and byte order of this machine, as written by fwrite of a T array.
+//
+// The same file is in every assignment that uses it; keep the copies
+// identical.
+template <class T, class Iterator = T*>
+class MappedVector {
+public:
+    using iterator = Iterator;
+private:
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector records are raw bytes on disk");
+
+    T* array;
+    size_t _size;
+
+    void _unmap() noexcept {
+        if (array != nullptr) {
+            munmap(array, _size * sizeof(T));
+        }
+        array = nullptr;
+        _size = 0;
+    }
+
+public:
+    MappedVector() noexcept : array(nullptr), _size(0) {}
+
+    explicit MappedVector(const std::string& path) : MappedVector() {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "fstat " + path);
+        }
+        size_t bytes = info.st_size;
+        if (bytes % sizeof(T) != 0) {
+            close(fd);
+            throw std::invalid_argument(path + " is not a whole number of records");
+        }
+        // mmap refuses empty mappings; an empty file is just an empty view
+        if (bytes != 0) {
+            void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mem == MAP_FAILED) {
+                int err = errno;
+                close(fd);
+                throw std::system_error(err, std::generic_category(), "mmap " + path);
+            }
+            array = static_cast<T*>(mem);
+            _size = bytes / sizeof(T);
+        }
+        // the mapping keeps the file alive on its own
+        close(fd);
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept : array(other.array), _size(other._size) {
+        other.array = nullptr;
+        other._size = 0;
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            _unmap();
+            array = other.array;
+            _size = other._size;
+            other.array = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    ~MappedVector() {
+        _unmap();
+    }
+
+    // Hints that the whole file will be read front to back, so the kernel
+    // reads ahead more aggressively. Only a hint; failures are ignored.
+    void advise_sequential() const noexcept {
+        if (array != nullptr) {
+            madvise(array, _size * sizeof(T), MADV_SEQUENTIAL);
+        }
+    }
+
+    iterator begin() noexcept {
+        return iterator(array);
+    }
+    iterator end() noexcept {
+        return iterator(array + _size);
+    }
+
+    T* data() noexcept {
+        return array;
+    }
+    const T* data() const noexcept {
+        return array;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    T& at(size_t pos) {
+        if (pos >= _size) {
+            throw std::out_of_range("Out of bounds access");
+        }
+        return array[pos];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= _size) {
+            throw std::out_of_range("Out of bounds access");
+        }
+        return array[pos];
+    }
+    T& operator[](size_t pos) {
+        return array[pos];
+    }
+    const T& operator[](size_t pos) const {
+        return array[pos];
+    }
+
+    T& front() {
+        return array[0];
+    }
+    const T& front() const {
+        return array[0];
+    }
+    T& back() {
+        return array[_size - 1];
+    }
+    const T& back() const {
+        return array[_size - 1];
+    }
+};
+
+#endif
@@ -5,12 +5,15 @@
 #include <string>
 #include <vector>
 
+#if !defined(_WIN32)
+#include "MappedVector.h"
+#endif
 #include "sorting.h"
 
 using std::chrono::duration, std::chrono::duration_cast, std::chrono::high_resolution_clock, std::chrono::time_point;
 using microseconds = std::chrono::duration<double, std::micro>;
 using milliseconds = std::chrono::duration<double, std::milli>;
-using std::ifstream;
+using std::ifstream, std::ofstream;
 using std::cerr, std::cin, std::cout, std::endl, std::ostream;
 using std::string;
 using std::vector;
@@ -50,6 +53,13 @@ ostream& operator<<(ostream& o, const Sort& sort);
 
 [[nodiscard]] vector<int> getFileData();
 
+#if !defined(_WIN32)
+// .bin files are memory mapped, which is POSIX only
+void convertFileData(const std::string & in_path, const std::string & out_path);
+
+[[nodiscard]] bool isBinaryFile(const std::string & filepath);
+#endif
+
 [[nodiscard]] vector<int> getManualData();
 
 [[nodiscard]] Sort getSortingAlgorithm();
@@ -130,10 +140,19 @@ SortingStats benchmark_sort(Sort sorting_algorithm, RandomIter begin, RandomIter
 
 void die_usage(const char * prog) {
 	cerr << "USAGE: " << prog << " [-b|-i|-s] file" << endl;
+#if !defined(_WIN32)
+	cerr << "       " << prog << " -c file.dat file.bin" << endl;
+#endif
 	exit(1);
 }
 
 void handle_command_usage(int argc, char** argv) {
+#if !defined(_WIN32)
+	if (argc == 4 && std::string(argv[1]) == "-c") {
+		convertFileData(argv[2], argv[3]);
+		return;
+	}
+#endif
 	if (argc != 3) {
 		die_usage(argv[0]);
 	}
@@ -151,9 +170,23 @@ void handle_command_usage(int argc, char** argv) {
 	}
 
 
-	std::vector<int> data = readFileData(file_opt);
-
-	SortingStats stats = benchmark_sort(sorting_algorithm, data.begin(), data.end());
+	SortingStats stats;
+#if !defined(_WIN32)
+	if (isBinaryFile(file_opt)) {
+		// sort the mapped file in place, no parse or copy step
+		try {
+			MappedVector<int> data(file_opt);
+			stats = benchmark_sort(sorting_algorithm, data.begin(), data.end());
+		} catch (const std::exception & e) {
+			cerr << "Could not map '" << file_opt << "': " << e.what() << '\n';
+			exit(1);
+		}
+	} else
+#endif
+	{
+		std::vector<int> data = readFileData(file_opt);
+		stats = benchmark_sort(sorting_algorithm, data.begin(), data.end());
+	}
 
 	cout.setf(std::ios::fixed);
 	cout.precision(3);
@@ -240,6 +273,43 @@ bool testIfSorted(RandomIter begin, RandomIter end, Comparator comp) {
     return retval;
 }
 
+#if !defined(_WIN32)
+// Rewrites a whitespace separated .dat file as raw ints for MappedVector
+void convertFileData(const std::string & in_path, const std::string & out_path) {
+    ifstream in{in_path};
+    if (!in.is_open()) {
+        cerr << "File not found: '" << in_path << "'\n";
+        exit(1);
+    }
+    ofstream out{out_path, std::ios::binary};
+    if (!out.is_open()) {
+        cerr << "Could not create: '" << out_path << "'\n";
+        exit(1);
+    }
+    // stream through a fixed buffer so any size of file converts
+    vector<int> buffer;
+    buffer.reserve(4096);
+    int value;
+    while (in >> value) {
+        buffer.push_back(value);
+        if (buffer.size() == buffer.capacity()) {
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(int));
+            buffer.clear();
+        }
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(int));
+    if (!out) {
+        cerr << "Failed writing: '" << out_path << "'\n";
+        exit(1);
+    }
+}
+
+[[nodiscard]] bool isBinaryFile(const std::string & filepath) {
+    const std::string ext = ".bin";
+    return filepath.size() >= ext.size() && filepath.compare(filepath.size() - ext.size(), ext.size(), ext) == 0;
+}
+#endif
+
 [[nodiscard]] vector<int> getFileData() {
     string filepath;
     cout << "Enter Filepath to Read: ";
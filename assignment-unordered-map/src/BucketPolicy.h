@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+#include "primes.h"
+
+// How UnorderedMap sizes its bucket array and maps a hash code to a
+// bucket. A policy has two static functions:
+//
+//   size_t bucket_count(size_t n)           the bucket count to use when
+//                                           at least n are asked for
+//   size_t index(size_t code, size_t count) the bucket of code, given a
+//                                           count from bucket_count
+//
+// index runs on every lookup, so it is where the policies differ.
+
+// Prime bucket counts and code % count. Every bit of the code counts, so
+// it copes with weak hashes, at the price of an integer division.
+struct PrimeBuckets {
+    static size_t bucket_count(size_t n) {
+        return next_greater_prime(n);
+    }
+    static size_t index(size_t code, size_t count) {
+        return code % count;
+    }
+};
+
+namespace bucket_policy_detail {
+    // Spreads every bit of the code into the high bits and back down into
+    // the low ones (a multiply and xor-shifts, as in the MurmurHash3
+    // finalizer), so hashes that only vary in a few bits still reach
+    // every bucket
+    inline uint64_t mix(uint64_t code) {
+        code ^= code >> 32;
+        code *= 0x9E3779B97F4A7C15ull;
+        code ^= code >> 29;
+        return code;
+    }
+
+    // The high 64 bits of a * b
+    inline uint64_t mul_high(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128;
+        return static_cast<uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#else
+        uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+        uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+        uint64_t lo_lo = a_lo * b_lo;
+        uint64_t hi_lo = a_hi * b_lo;
+        uint64_t lo_hi = a_lo * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+}
+
+// Power of two bucket counts and a mask. The mask keeps only the low bits
+// of the code, which hashes like first_character_hash barely vary, so
+// the code is mixed first.
+struct PowerOfTwoBuckets {
+    static size_t bucket_count(size_t n) {
+        size_t count = 2;
+        while (count < n) {
+            count *= 2;
+        }
+        return count;
+    }
+    static size_t index(size_t code, size_t count) {
+        return bucket_policy_detail::mix(code) & (count - 1);
+    }
+};
+
+// Any bucket count, with Lemire's multiply-shift range reduction: the
+// high word of code * count is in [0, count) and spread evenly when the
+// code is. Small codes would all land in bucket 0, so the code is mixed
+// first, as for PowerOfTwoBuckets.
+struct FastRangeBuckets {
+    static size_t bucket_count(size_t n) {
+        return n < 2 ? 2 : n;
+    }
+    static size_t index(size_t code, size_t count) {
+        return bucket_policy_detail::mul_high(bucket_policy_detail::mix(code), count);
+    }
+};
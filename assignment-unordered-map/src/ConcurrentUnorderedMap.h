@@ -0,0 +1,364 @@
+#pragma once
+
+#include <atomic>       // std::atomic
+#include <cmath>        // std::ceil
+#include <cstddef>      // size_t
+#include <functional>   // std::hash
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::unique_lock
+#include <optional>     // std::optional
+#include <shared_mutex> // std::shared_mutex, std::shared_lock
+#include <stdexcept>    // std::invalid_argument
+#include <utility>      // std::pair
+#include <vector>
+
+#include "BucketPolicy.h"
+
+// An unordered map that any number of threads can use at once, with lock
+// striping: the buckets are split into contiguous ranges, each guarded by
+// its own reader/writer lock, so threads working in different ranges do
+// not wait on each other. Lookups share their stripe; insert and erase
+// hold it alone. rehash, and the growth that inserts trigger past the
+// max load factor, hold every stripe, relinking the nodes in place.
+//
+// Nodes cache their hash code as UnorderedMap's do, and buckets come from
+// the same BucketPolicy. Unlike UnorderedMap, each bucket has its own
+// chain: UnorderedMap links all nodes into one list, which an insert into
+// an empty bucket changes outside its own bucket.
+//
+// There are no iterators, since nothing would keep an element alive or
+// in place while one pointed at it. find copies the value out; visit and
+// insert_or_visit run a function on the element under its stripe's lock.
+// Such a function must not call back into the map.
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>,
+          typename BucketPolicy = PrimeBuckets>
+class ConcurrentUnorderedMap {
+    public:
+
+    using key_type = Key;
+    using mapped_type = T;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using size_type = size_t;
+
+    private:
+
+    struct HashNode {
+        HashNode *next;
+        size_type code;
+        value_type val;
+
+        template <typename... Args>
+        HashNode(size_type code, Args &&... args) : next { nullptr }, code { code }, val(std::forward<Args>(args)...) { }
+    };
+
+    // One per stripe, each on its own cache line so that taking one lock
+    // does not slow down threads taking its neighbours
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex mutex;
+    };
+
+    using SharedLock = std::shared_lock<std::shared_mutex>;
+    using UniqueLock = std::unique_lock<std::shared_mutex>;
+
+    // Bucket b is guarded by stripe b * _stripe_count / _bucket_count.
+    // _buckets and _bucket_count only change with every stripe held, so
+    // holding any one stripe keeps them still.
+    HashNode **_buckets;
+    std::atomic<size_type> _bucket_count;
+    std::unique_ptr<Stripe[]> _stripes;
+    size_type _stripe_count;
+
+    std::atomic<size_type> _size;
+    std::atomic<float> _max_load_factor;
+
+    Hash _hash;
+    key_equal _equal;
+
+    // Locks the stripe of code's bucket, in shared or unique mode, and
+    // returns the bucket. The bucket count is read before the lock is
+    // taken, so it is checked again after, in case a rehash came between.
+    template <typename Lock>
+    size_type _lock_bucket(size_type code, Lock & lock) const {
+        while (true) {
+            size_type count = _bucket_count.load(std::memory_order_acquire);
+            size_type bucket = BucketPolicy::index(code, count);
+            Lock held(_stripes[bucket * _stripe_count / count].mutex);
+            if (count == _bucket_count.load(std::memory_order_relaxed)) {
+                lock = std::move(held);
+                return bucket;
+            }
+        }
+    }
+
+    // Every stripe, in order, so that two threads doing this never
+    // deadlock
+    std::vector<UniqueLock> _lock_all() const {
+        std::vector<UniqueLock> locks;
+        locks.reserve(_stripe_count);
+        for (size_type s = 0; s < _stripe_count; s++) {
+            locks.emplace_back(_stripes[s].mutex);
+        }
+        return locks;
+    }
+
+    // The link that points at key's node in bucket, or at the null that
+    // ends the chain when it is not there
+    HashNode** _find_link(size_type bucket, size_type code, const Key & key) const {
+        HashNode** link = &_buckets[bucket];
+        while (*link != nullptr) {
+            if ((*link)->code == code && _equal((*link)->val.first, key)) {
+                return link;
+            }
+            link = &(*link)->next;
+        }
+        return link;
+    }
+
+    // Adds a node to the front of bucket, whose stripe is held
+    void _link(size_type bucket, HashNode * node) {
+        node->next = _buckets[bucket];
+        _buckets[bucket] = node;
+        _size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_type _buckets_for(size_type count) const {
+        return static_cast<size_type>(std::ceil(count / _max_load_factor.load(std::memory_order_relaxed)));
+    }
+
+    // With every stripe held, moves to the policy's bucket count for
+    // count buckets, or for what the size needs if that is more
+    void _rehash_locked(size_type count) {
+        size_type needed = _buckets_for(_size.load(std::memory_order_relaxed));
+        size_type new_count = BucketPolicy::bucket_count(count > needed ? count : needed);
+        size_type old_count = _bucket_count.load(std::memory_order_relaxed);
+        if (new_count == old_count) {
+            return;
+        }
+
+        HashNode** buckets = new HashNode*[new_count]();
+        for (size_type b = 0; b < old_count; b++) {
+            HashNode* node = _buckets[b];
+            while (node != nullptr) {
+                HashNode* next = node->next;
+                size_type bucket = BucketPolicy::index(node->code, new_count);
+                node->next = buckets[bucket];
+                buckets[bucket] = node;
+                node = next;
+            }
+        }
+        delete[] _buckets;
+        _buckets = buckets;
+        _bucket_count.store(new_count, std::memory_order_release);
+    }
+
+    bool _over_load(size_type count) const {
+        return _size.load(std::memory_order_relaxed) > _max_load_factor.load(std::memory_order_relaxed) * count;
+    }
+
+    // Called after an insert has let go of its stripe. Threads that race
+    // here line up for the stripes, and all but the first find the table
+    // already grown.
+    void _grow_if_needed() {
+        if (!_over_load(_bucket_count.load(std::memory_order_relaxed))) {
+            return;
+        }
+        std::vector<UniqueLock> locks = _lock_all();
+        size_type count = _bucket_count.load(std::memory_order_relaxed);
+        if (_over_load(count)) {
+            _rehash_locked(count * 2);
+        }
+    }
+
+    void _free_nodes() {
+        size_type count = _bucket_count.load(std::memory_order_relaxed);
+        for (size_type b = 0; b < count; b++) {
+            HashNode* node = _buckets[b];
+            while (node != nullptr) {
+                HashNode* next = node->next;
+                delete node;
+                node = next;
+            }
+            _buckets[b] = nullptr;
+        }
+        _size.store(0, std::memory_order_relaxed);
+    }
+
+    // Inserts a node built from args if key is missing, or else runs f on
+    // the element already there. Returns whether it inserted.
+    template <typename F, typename... Args>
+    bool _insert_or(const Key & key, F && f, Args &&... args) {
+        size_type code = _hash(key);
+        {
+            UniqueLock lock;
+            size_type bucket = _lock_bucket(code, lock);
+            HashNode** link = _find_link(bucket, code, key);
+            if (*link != nullptr) {
+                f((*link)->val);
+                return false;
+            }
+            _link(bucket, new HashNode(code, std::forward<Args>(args)...));
+        }
+        _grow_if_needed();
+        return true;
+    }
+
+    public:
+
+    // stripes is how many locks the buckets share; more than the number
+    // of threads makes two of them less likely to want the same one
+    explicit ConcurrentUnorderedMap(size_type bucket_count, const Hash & hash = Hash { },
+                const key_equal & equal = key_equal { }, size_type stripes = 64)
+                : _stripe_count(stripes > 0 ? stripes : 1), _size(0), _max_load_factor(1.0f),
+                  _hash(hash), _equal(equal) {
+        size_type count = BucketPolicy::bucket_count(bucket_count);
+        _buckets = new HashNode*[count]();
+        _bucket_count.store(count);
+        _stripes.reset(new Stripe[_stripe_count]);
+    }
+
+    ~ConcurrentUnorderedMap() {
+        _free_nodes();
+        delete[] _buckets;
+    }
+
+    // The locks can be neither copied nor moved, and a map in use by
+    // other threads could not be copied consistently anyway
+    ConcurrentUnorderedMap(const ConcurrentUnorderedMap &) = delete;
+    ConcurrentUnorderedMap & operator=(const ConcurrentUnorderedMap &) = delete;
+
+    // A snapshot: by the time it returns, other threads may have changed
+    // the map
+    size_type size() const noexcept { return _size.load(std::memory_order_relaxed); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type bucket_count() const noexcept { return _bucket_count.load(std::memory_order_relaxed); }
+
+    float load_factor() const { return float(size())/float(bucket_count()); }
+
+    float max_load_factor() const noexcept { return _max_load_factor.load(std::memory_order_relaxed); }
+
+    void max_load_factor(float ml) {
+        if (!(ml > 0)) {
+            throw std::invalid_argument("max_load_factor must be positive");
+        }
+        _max_load_factor.store(ml, std::memory_order_relaxed);
+        _grow_if_needed();
+    }
+
+    // Safe to call while other threads use the map; they wait for it
+    void rehash(size_type count) {
+        std::vector<UniqueLock> locks = _lock_all();
+        _rehash_locked(count);
+    }
+
+    // Never shrinks the table, like UnorderedMap's
+    void reserve(size_type count) {
+        std::vector<UniqueLock> locks = _lock_all();
+        size_type needed = _buckets_for(count);
+        if (needed > _bucket_count.load(std::memory_order_relaxed)) {
+            _rehash_locked(needed);
+        }
+    }
+
+    void clear() {
+        std::vector<UniqueLock> locks = _lock_all();
+        _free_nodes();
+    }
+
+    bool insert(const value_type & value) {
+        return _insert_or(value.first, [](value_type &) {}, value);
+    }
+
+    bool insert(value_type && value) {
+        return _insert_or(value.first, [](value_type &) {}, std::move(value));
+    }
+
+    // Assigns obj to key's value, inserting key if it is missing. Returns
+    // whether it inserted.
+    template <typename M>
+    bool insert_or_assign(const Key & key, M && obj) {
+        return _insert_or(key, [&](value_type & existing) {
+            existing.second = std::forward<M>(obj);
+        }, key, std::forward<M>(obj));
+    }
+
+    // Inserts value if its key is missing, or else runs f on the element
+    // already there, so a count can be started or bumped in one step:
+    //
+    //     map.insert_or_visit({word, 1}, [](auto & pair) { pair.second++; });
+    template <typename F>
+    bool insert_or_visit(const value_type & value, F && f) {
+        return _insert_or(value.first, std::forward<F>(f), value);
+    }
+
+    // Runs f on key's element, if there is one, with its stripe held
+    // alone. Returns whether it found one.
+    template <typename F>
+    bool visit(const Key & key, F && f) {
+        size_type code = _hash(key);
+        UniqueLock lock;
+        size_type bucket = _lock_bucket(code, lock);
+        HashNode* node = *_find_link(bucket, code, key);
+        if (node == nullptr) {
+            return false;
+        }
+        f(node->val);
+        return true;
+    }
+
+    // A copy of key's value, if it has one
+    std::optional<T> find(const Key & key) const {
+        size_type code = _hash(key);
+        SharedLock lock;
+        size_type bucket = _lock_bucket(code, lock);
+        HashNode* node = *_find_link(bucket, code, key);
+        if (node == nullptr) {
+            return std::nullopt;
+        }
+        return node->val.second;
+    }
+
+    bool contains(const Key & key) const {
+        size_type code = _hash(key);
+        SharedLock lock;
+        size_type bucket = _lock_bucket(code, lock);
+        return *_find_link(bucket, code, key) != nullptr;
+    }
+
+    // The node is freed after its stripe is released
+    size_type erase(const Key & key) {
+        size_type code = _hash(key);
+        HashNode* node;
+        {
+            UniqueLock lock;
+            size_type bucket = _lock_bucket(code, lock);
+            HashNode** link = _find_link(bucket, code, key);
+            node = *link;
+            if (node == nullptr) {
+                return 0;
+            }
+            *link = node->next;
+            _size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        delete node;
+        return 1;
+    }
+
+    // Runs f on every element with every stripe held, so it sees the map
+    // as it was at one moment
+    template <typename F>
+    void for_each(F && f) const {
+        std::vector<UniqueLock> locks = _lock_all();
+        size_type count = _bucket_count.load(std::memory_order_relaxed);
+        for (size_type b = 0; b < count; b++) {
+            for (const HashNode* node = _buckets[b]; node != nullptr; node = node->next) {
+                f(static_cast<const_reference>(node->val));
+            }
+        }
+    }
+};
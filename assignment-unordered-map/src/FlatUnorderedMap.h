@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cmath>      // std::ceil
+#include <cstddef>    // size_t
+#include <cstdint>    // uint32_t
+#include <functional> // std::hash
+#include <memory>     // std::allocator
+#include <new>        // placement new
+#include <stdexcept>  // std::invalid_argument
+#include <tuple>      // std::forward_as_tuple
+#include <utility>    // std::pair
+
+#include "primes.h"
+
+// An unordered map with the interface of UnorderedMap and no nodes. The
+// values sit next to each other in one array, in no particular order, and
+// a bucket array of 8 byte entries indexes them by hash. Iterating walks
+// the value array; a lookup probes the bucket array and touches one value.
+//
+// Buckets use open addressing with linear probing and Robin Hood
+// insertion: an entry takes the place of any entry closer to its own home
+// bucket, which keeps every probe sequence short. Erasing shifts the
+// following entries back instead of leaving a tombstone, and fills the
+// hole in the value array with the last value.
+//
+// Unlike UnorderedMap, inserting may move values, so it invalidates
+// iterators and references when the table grows, and erasing moves the
+// last value into the erased one's place.
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>>
+class FlatUnorderedMap {
+    public:
+
+    using key_type = Key;
+    using mapped_type = T;
+    using hasher = Hash;
+    using key_equal = Pred;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    private:
+
+    // dist_fp packs how far the entry is from its home bucket, plus one,
+    // above 8 bits of its hash. Zero is an empty bucket. Comparing packed
+    // values orders entries by distance first, which is all Robin Hood
+    // needs, and the fingerprint rules out most mismatches before a key
+    // is compared.
+    struct Bucket {
+        uint32_t dist_fp;
+        uint32_t index;
+    };
+
+    static constexpr uint32_t _dist_inc = 1u << 8;
+    static constexpr uint32_t _fp_mask = _dist_inc - 1;
+
+    // The values are stored with a mutable key, so that growing and erasing
+    // can move keys from slot to slot. Users only ever see them through
+    // the iterator, as value_type, with the key const.
+    using slot_type = std::pair<key_type, mapped_type>;
+    static_assert(sizeof(slot_type) == sizeof(value_type) && alignof(slot_type) == alignof(value_type),
+                  "a slot is handed out as a value_type");
+
+    static value_type & _as_value(slot_type & slot) noexcept {
+        return *reinterpret_cast<value_type *>(&slot);
+    }
+
+    // Where a key is, or where it would go
+    struct Probe {
+        size_type bucket;
+        uint32_t dist_fp;
+        bool found;
+    };
+
+    std::allocator<slot_type> _alloc;
+
+    Bucket *_buckets;
+    // The values, in [0, _size), and the full hash of each, which rehash
+    // and erase reuse. Both hold _bucket_count entries, except in the
+    // empty table a map is left with when moved from, which has neither.
+    slot_type *_values;
+    size_type *_codes;
+    size_type _size;
+    size_type _bucket_count;
+    float _max_load_factor = 0.8f;
+
+    Hash _hash;
+    key_equal _equal;
+
+    static size_type _range_hash(size_type hash_code, size_type bucket_count) {
+        return hash_code % bucket_count;
+    }
+
+    public:
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+    private:
+        friend class FlatUnorderedMap<Key, T, Hash, key_equal>;
+
+        slot_type * _value;
+
+        explicit iterator(slot_type *ptr) noexcept { _value = ptr; }
+
+    public:
+        iterator() { _value = nullptr; };
+        iterator(const iterator &) = default;
+        iterator(iterator &&) = default;
+        ~iterator() = default;
+        iterator &operator=(const iterator &) = default;
+        iterator &operator=(iterator &&) = default;
+        reference operator*() const { return _as_value(*_value); }
+        pointer operator->() const { return &_as_value(*_value); }
+        iterator &operator++() {
+            _value++;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator hold = iterator(_value);
+            _value++;
+            return hold;
+        }
+        bool operator==(const iterator &other) const noexcept {
+            return _value == other._value;
+        }
+        bool operator!=(const iterator &other) const noexcept {
+            return _value != other._value;
+        }
+    };
+
+private:
+
+    size_type _bucket(size_type code) const { return _range_hash(code, _bucket_count); }
+
+    size_type _next(size_type bucket) const {
+        return bucket + 1 == _bucket_count ? 0 : bucket + 1;
+    }
+
+    static uint32_t _first_dist_fp(size_type code) {
+        return _dist_inc | static_cast<uint32_t>(code & _fp_mask);
+    }
+
+    // Moves a value to uninitialized memory and destroys the original
+    static void _relocate(slot_type * to, slot_type * from) {
+        new (to) slot_type(std::move(*from));
+        from->~slot_type();
+    }
+
+    Probe _probe(size_type code, const Key & key) const {
+        size_type bucket = _bucket(code);
+        uint32_t dist_fp = _first_dist_fp(code);
+        // an entry nearer its home than this key is to its own means the
+        // key would have taken its place, so it is not in the table
+        while (dist_fp <= _buckets[bucket].dist_fp) {
+            if (dist_fp == _buckets[bucket].dist_fp &&
+                _equal(_values[_buckets[bucket].index].first, key)) {
+                return Probe { bucket, dist_fp, true };
+            }
+            dist_fp += _dist_inc;
+            bucket = _next(bucket);
+        }
+        return Probe { bucket, dist_fp, false };
+    }
+
+    // Where a key known not to be in the table goes
+    Probe _probe_new(size_type code) const {
+        size_type bucket = _bucket(code);
+        uint32_t dist_fp = _first_dist_fp(code);
+        while (dist_fp <= _buckets[bucket].dist_fp) {
+            dist_fp += _dist_inc;
+            bucket = _next(bucket);
+        }
+        return Probe { bucket, dist_fp, false };
+    }
+
+    // The bucket of the value at index
+    size_type _bucket_of(size_type index) const {
+        size_type bucket = _bucket(_codes[index]);
+        while (_buckets[bucket].index != index || _buckets[bucket].dist_fp == 0) {
+            bucket = _next(bucket);
+        }
+        return bucket;
+    }
+
+    // Puts an entry at the probed bucket, carrying the entries from there
+    // to the next empty bucket one further from home
+    void _place(Probe probe, uint32_t index) {
+        Bucket carry { probe.dist_fp, index };
+        size_type bucket = probe.bucket;
+        while (_buckets[bucket].dist_fp != 0) {
+            std::swap(carry, _buckets[bucket]);
+            carry.dist_fp += _dist_inc;
+            bucket = _next(bucket);
+        }
+        _buckets[bucket] = carry;
+    }
+
+    // One empty bucket, shared by every moved from map so that moving
+    // allocates nothing. Lookups find nothing in it, and the first insert
+    // grows out of it, since it has no room for values. It is never
+    // written.
+    static Bucket * _empty_buckets() noexcept {
+        static Bucket empty[1] = { };
+        return empty;
+    }
+
+    void _make_empty() noexcept {
+        _buckets = _empty_buckets();
+        _values = nullptr;
+        _codes = nullptr;
+        _size = 0;
+        _bucket_count = 1;
+    }
+
+    void _allocate(size_type bucket_count) {
+        _bucket_count = bucket_count;
+        _buckets = new Bucket[_bucket_count]();
+        _codes = new size_type[_bucket_count];
+        _values = _alloc.allocate(_bucket_count);
+    }
+
+    // Frees a table's arrays, unless it is the empty one
+    void _free_arrays(Bucket * buckets, slot_type * values, size_type * codes, size_type bucket_count) {
+        if (values == nullptr) {
+            return;
+        }
+        _alloc.deallocate(values, bucket_count);
+        delete[] codes;
+        delete[] buckets;
+    }
+
+    void _deallocate() {
+        for (size_type i = 0; i < _size; i++) {
+            _values[i].~slot_type();
+        }
+        _free_arrays(_buckets, _values, _codes, _bucket_count);
+    }
+
+    // Fewest buckets that keep count elements within the max load factor
+    size_type _buckets_for(size_type count) const {
+        return static_cast<size_type>(std::ceil(count / _max_load_factor));
+    }
+
+    bool _grow_for_insert() {
+        if (_values != nullptr && _size + 1 <= _max_load_factor * _bucket_count) {
+            return false;
+        }
+        size_type needed = _buckets_for(_size + 1);
+        rehash(needed > _bucket_count * 2 ? needed : _bucket_count * 2);
+        return true;
+    }
+
+    // Constructs the value for a key that probe found missing. The value
+    // is built before any bucket changes, so a throwing constructor leaves
+    // the map as it was.
+    template <typename... Args>
+    iterator _emplace_new(Probe probe, size_type code, Args &&... args) {
+        if (_grow_for_insert()) {
+            probe = _probe_new(code);
+        }
+        new (_values + _size) slot_type(std::forward<Args>(args)...);
+        _codes[_size] = code;
+        _place(probe, static_cast<uint32_t>(_size));
+        return iterator(_values + _size++);
+    }
+
+    // Removes the entry in bucket, shifting the entries after it back
+    // toward home until one is already there, then fills its hole in the
+    // value array with the last value. Returns the index the value was at.
+    size_type _erase_bucket(size_type bucket) {
+        size_type index = _buckets[bucket].index;
+        size_type next = _next(bucket);
+        while (_buckets[next].dist_fp >= 2 * _dist_inc) {
+            _buckets[bucket] = Bucket { _buckets[next].dist_fp - _dist_inc, _buckets[next].index };
+            bucket = next;
+            next = _next(next);
+        }
+        _buckets[bucket] = Bucket { 0, 0 };
+
+        size_type last = _size - 1;
+        _values[index].~slot_type();
+        if (index != last) {
+            _buckets[_bucket_of(last)].index = static_cast<uint32_t>(index);
+            _relocate(_values + index, _values + last);
+            _codes[index] = _codes[last];
+        }
+        _size--;
+        return index;
+    }
+
+public:
+    explicit FlatUnorderedMap(size_type bucket_count, const Hash & hash = Hash { },
+                const key_equal & equal = key_equal { }): _size(0), _hash(hash), _equal(equal) {
+                    _allocate(next_greater_prime(bucket_count));
+    }
+
+    ~FlatUnorderedMap() {
+        _deallocate();
+    }
+
+    FlatUnorderedMap(const FlatUnorderedMap & other) : _size(0), _hash(other._hash), _equal(other._equal) {
+        _max_load_factor = other._max_load_factor;
+        _allocate(other._bucket_count);
+        // same bucket count and codes, so the same layout
+        try {
+            for (; _size < other._size; _size++) {
+                new (_values + _size) slot_type(other._values[_size]);
+                _codes[_size] = other._codes[_size];
+            }
+        }
+        catch (...) {
+            _deallocate();
+            throw;
+        }
+        for (size_type b = 0; b < _bucket_count; b++) {
+            _buckets[b] = other._buckets[b];
+        }
+    }
+
+    // other is left with the empty table, and allocates again when it
+    // next grows
+    FlatUnorderedMap(FlatUnorderedMap && other) noexcept : _hash(other._hash), _equal(other._equal) {
+        _max_load_factor = other._max_load_factor;
+        _make_empty();
+        swap(other);
+    }
+
+    FlatUnorderedMap & operator=(const FlatUnorderedMap & other) {
+        if (this != &other) {
+            FlatUnorderedMap copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatUnorderedMap & operator=(FlatUnorderedMap && other) {
+        if (this != &other) {
+            swap(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    void swap(FlatUnorderedMap & other) noexcept {
+        std::swap(_buckets, other._buckets);
+        std::swap(_values, other._values);
+        std::swap(_codes, other._codes);
+        std::swap(_size, other._size);
+        std::swap(_bucket_count, other._bucket_count);
+        std::swap(_max_load_factor, other._max_load_factor);
+        std::swap(_hash, other._hash);
+        std::swap(_equal, other._equal);
+    }
+
+    void clear() noexcept {
+        if (_values == nullptr) {
+            return;
+        }
+        for (size_type i = 0; i < _size; i++) {
+            _values[i].~slot_type();
+        }
+        for (size_type b = 0; b < _bucket_count; b++) {
+            _buckets[b] = Bucket { 0, 0 };
+        }
+        _size = 0;
+    }
+
+    size_type size() const noexcept { return _size; }
+
+    bool empty() const noexcept { return _size == 0; }
+
+    size_type bucket_count() const noexcept { return _bucket_count; }
+
+    iterator begin() { return iterator(_values); }
+
+    iterator end() { return iterator(_values + _size); }
+
+    float load_factor() const { return float(_size)/float(_bucket_count); }
+
+    float max_load_factor() const noexcept { return _max_load_factor; }
+
+    // Every value needs a bucket of its own, so the load factor can not
+    // go past 1
+    void max_load_factor(float ml) {
+        if (!(ml > 0 && ml <= 1)) {
+            throw std::invalid_argument("max_load_factor must be in (0, 1]");
+        }
+        _max_load_factor = ml;
+        if (load_factor() > _max_load_factor) {
+            rehash(0);
+        }
+    }
+
+    // Moves to the next prime above count buckets, or above what the
+    // current size needs if that is more. Values are moved to the new
+    // array and placed by their stored codes, without hashing.
+    void rehash(size_type count) {
+        size_type needed = _buckets_for(_size);
+        size_type new_count = next_greater_prime(count > needed ? count : needed);
+        if (new_count == _bucket_count) {
+            return;
+        }
+
+        Bucket *buckets = _buckets;
+        slot_type *values = _values;
+        size_type *codes = _codes;
+        size_type bucket_count = _bucket_count;
+        _allocate(new_count);
+
+        for (size_type i = 0; i < _size; i++) {
+            _relocate(_values + i, values + i);
+            _codes[i] = codes[i];
+            _place(_probe_new(_codes[i]), static_cast<uint32_t>(i));
+        }
+
+        _free_arrays(buckets, values, codes, bucket_count);
+    }
+
+    // Makes room for count elements without going over the max load factor
+    void reserve(size_type count) {
+        rehash(_buckets_for(count));
+    }
+
+    std::pair<iterator, bool> insert(value_type && value) {
+        size_type code = _hash(value.first);
+        Probe probe = _probe(code, value.first);
+        if (probe.found) {
+            return std::make_pair(iterator(_values + _buckets[probe.bucket].index), false);
+        }
+        return std::make_pair(_emplace_new(probe, code, std::move(value)), true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type & value) {
+        size_type code = _hash(value.first);
+        Probe probe = _probe(code, value.first);
+        if (probe.found) {
+            return std::make_pair(iterator(_values + _buckets[probe.bucket].index), false);
+        }
+        return std::make_pair(_emplace_new(probe, code, value), true);
+    }
+
+    iterator find(const Key & key) {
+        Probe probe = _probe(_hash(key), key);
+        if (probe.found) {
+            return iterator(_values + _buckets[probe.bucket].index);
+        }
+        return end();
+    }
+
+    T& operator[](const Key & key) {
+        size_type code = _hash(key);
+        Probe probe = _probe(code, key);
+        if (probe.found) {
+            return _values[_buckets[probe.bucket].index].second;
+        }
+        return _emplace_new(probe, code, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple())->second;
+    }
+
+    // The returned iterator is pos again, now holding what was the last
+    // value, so erasing while iterating visits everything once
+    iterator erase(iterator pos) {
+        size_type index = pos._value - _values;
+        return iterator(_values + _erase_bucket(_bucket_of(index)));
+    }
+
+    size_type erase(const Key & key) {
+        Probe probe = _probe(_hash(key), key);
+        if (!probe.found) {
+            return 0;
+        }
+        _erase_bucket(probe.bucket);
+        return 1;
+    }
+};
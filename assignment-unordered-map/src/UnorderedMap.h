@@ -1,11 +1,33 @@
+#include <cmath>      // std::ceil, std::isinf
 #include <cstddef>    // size_t
 #include <functional> // std::hash
-#include <utility>    // std::pair
+#include <stdexcept>  // std::invalid_argument
+#include <tuple>      // std::forward_as_tuple
+#include <type_traits> // std::enable_if_t, std::void_t
+#include <utility>    // std::pair, std::piecewise_construct
 #include <iostream>
-
-#include "primes.h"
-
-template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>>
+#include <limits>     // std::numeric_limits
+
+#include "BucketPolicy.h"
+
+namespace unordered_map_detail {
+    // Whether F declares is_transparent, promising it takes any key type
+    // that compares or hashes like the map's own keys
+    template <typename F, typename = void>
+    struct is_transparent : std::false_type {};
+    template <typename F>
+    struct is_transparent<F, std::void_t<typename F::is_transparent>> : std::true_type {};
+
+    // Enables the overloads for keys of another type when both the hash
+    // and the predicate are transparent
+    template <typename H, typename P>
+    using if_transparent = std::enable_if_t<is_transparent<H>::value && is_transparent<P>::value>;
+}
+
+// BucketPolicy picks the bucket counts and how a hash code is reduced to
+// a bucket, see BucketPolicy.h
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>,
+          typename BucketPolicy = PrimeBuckets>
 class UnorderedMap {
     public:
 
@@ -23,18 +45,25 @@ class UnorderedMap {
 
     private:
 
+    // code is the full hash of val.first, kept so that walking a chain
+    // or rehashing never hashes a stored key again
     struct HashNode {
         HashNode *next;
+        size_type code;
         value_type val;
 
-        HashNode(HashNode *next = nullptr) : next{next} {}
-        HashNode(const value_type & val, HashNode * next = nullptr) : next { next }, val { val } { }
-        HashNode(value_type && val, HashNode * next = nullptr) : next { next }, val { std::move(val) } { }
+        HashNode(HashNode *next = nullptr) : next{next}, code{0} {}
+        // val is built in place from args
+        template <typename... Args>
+        HashNode(size_type code, Args &&... args) : next { nullptr }, code { code }, val(std::forward<Args>(args)...) { }
     };
 
     HashNode **_buckets;
     size_type _size;
     size_type _bucket_count;
+    // Unbounded unless set, so a map keeps the bucket count it was built
+    // with; any finite value makes inserts grow the table to stay under it
+    float _max_load_factor = std::numeric_limits<float>::infinity();
 
     HashNode _head;
 
@@ -42,7 +71,7 @@ class UnorderedMap {
     key_equal _equal;
 
     static size_type _range_hash(size_type hash_code, size_type bucket_count) {
-        return hash_code % bucket_count;
+        return BucketPolicy::index(hash_code, bucket_count);
     }
 
     public:
@@ -56,8 +85,8 @@ class UnorderedMap {
         using reference = value_type &;
 
     private:
-        friend class UnorderedMap<Key, T, Hash, key_equal>;
-        using HashNode = typename UnorderedMap<Key, T, Hash, key_equal>::HashNode;
+        friend class UnorderedMap<Key, T, Hash, key_equal, BucketPolicy>;
+        using HashNode = typename UnorderedMap<Key, T, Hash, key_equal, BucketPolicy>::HashNode;
 
         HashNode * _node;
 
@@ -104,8 +133,8 @@ class UnorderedMap {
             using reference = value_type &;
 
         private:
-            friend class UnorderedMap<Key, T, Hash, key_equal>;
-            using HashNode = typename UnorderedMap<Key, T, Hash, key_equal>::HashNode;
+            friend class UnorderedMap<Key, T, Hash, key_equal, BucketPolicy>;
+            using HashNode = typename UnorderedMap<Key, T, Hash, key_equal, BucketPolicy>::HashNode;
 
             UnorderedMap * _map;
             HashNode * _node;
@@ -127,7 +156,7 @@ class UnorderedMap {
             reference operator*() const { return _node->val; }
             pointer operator->() const { return &(_node->val); }
             local_iterator & operator++() {
-                if (_node->next && _bucket == _map->_bucket(_node->next->val.first)) {
+                if (_node->next && _bucket == _map->_bucket(_node->next->code)) {
                     _node = _node->next;
                     return *this;
                 }
@@ -136,7 +165,7 @@ class UnorderedMap {
             }
             local_iterator operator++(int) {
                 local_iterator hold = local_iterator(_map, _node, _bucket);
-                if (_node->next && _bucket == _map->_bucket(_node->next->val.first)) {
+                if (_node->next && _bucket == _map->_bucket(_node->next->code)) {
                     _node = _node->next;
                     return hold;
                 }
@@ -159,15 +188,15 @@ class UnorderedMap {
 
 private:
 
+    // by code only, as a size_t key would make a key overload ambiguous
     size_type _bucket(size_t code) const { return _range_hash(code, _bucket_count); }
-    size_type _bucket(const Key &key) const { return _bucket(_hash(key)); }
 
     void _insert_before(size_type bucket, HashNode *node) {
         HashNode*& hold = _buckets[bucket];
         if (hold == nullptr) {
             node->next = _head.next;
             if (_head.next != nullptr) {
-                _buckets[_bucket(_head.next->val.first)] = node;
+                _buckets[_bucket(_head.next->code)] = node;
             }
             _head.next = node;
             hold = &_head;
@@ -186,13 +215,20 @@ private:
         return _buckets[bucket]->next;
     }
 
-    HashNode* _find_prev(size_type code, size_type bucket, const Key & key) {
+    // K is Key, or any type the hash and predicate take when transparent
+    template <typename K>
+    HashNode* _find_prev(size_type code, size_type bucket, const K & key) {
         if (_buckets[bucket] == nullptr || _buckets[bucket]->next == nullptr) {
             return nullptr;
         }
         HashNode* hold = _buckets[bucket];
         while (hold && (hold->next != nullptr)) {
-            if (code != _hash(hold->next->val.first)) {
+            // the cached code rules out most nodes without key_equal, and
+            // tells where the bucket ends without hashing the key again
+            if (code != hold->next->code) {
+                if (_bucket(hold->next->code) != bucket) {
+                    return nullptr;
+                }
                 hold = hold->next;
                 continue;
             }
@@ -204,8 +240,39 @@ private:
         return nullptr;
     }
 
-    HashNode* _find_prev(const Key & key) {
-        return _find_prev(_hash(key), _bucket(_hash(key)), key);
+    // What one hash and one chain walk learn about a key: its code, its
+    // bucket, and the node before it, or nullptr when it is not in the map
+    struct Lookup {
+        size_type code;
+        size_type bucket;
+        HashNode* prev;
+    };
+
+    template <typename K>
+    Lookup _lookup(const K & key) {
+        size_type code = _hash(key);
+        size_type bucket = _bucket(code);
+        return Lookup { code, bucket, _find_prev(code, bucket, key) };
+    }
+
+    // The node before node, found by address from the start of its bucket
+    HashNode* _prev_of(HashNode * node) {
+        HashNode* hold = _buckets[_bucket(node->code)];
+        while (hold->next != node) {
+            hold = hold->next;
+        }
+        return hold;
+    }
+
+    // Adds a node built from args for a key that lookup found missing
+    template <typename... Args>
+    iterator _emplace_new(Lookup & lookup, Args &&... args) {
+        if (_grow_for_insert()) {
+            lookup.bucket = _bucket(lookup.code);
+        }
+        HashNode* node = new HashNode(lookup.code, std::forward<Args>(args)...);
+        _insert_before(lookup.bucket, node);
+        return iterator(node);
     }
 
     void _erase_after(HashNode * prev) {
@@ -217,13 +284,13 @@ private:
             return;
         }
         HashNode* _next = hold->next;
-        size_type bucket_hold = _bucket(hold->val.first);
+        size_type bucket_hold = _bucket(hold->code);
         size_type bucket_next;
         prev->next = _next;
         _size--;
         delete hold;
         if (_next) {
-            bucket_next = _bucket(_next->val.first);
+            bucket_next = _bucket(_next->code);
         }
         else {
             bucket_next = -1;
@@ -236,12 +303,36 @@ private:
         }
     }
 
+    // Copies other's nodes, whose keys are already unique, reusing their
+    // hash codes
+    void _copy_nodes(const UnorderedMap & other) {
+        for (HashNode* hold = other._head.next; hold != nullptr; hold = hold->next) {
+            _grow_for_insert();
+            _insert_before(_bucket(hold->code), new HashNode(hold->code, hold->val));
+        }
+    }
+
+    // Fewest buckets that keep count elements within the max load factor
+    size_type _buckets_for(size_type count) const {
+        return static_cast<size_type>(std::ceil(count / _max_load_factor));
+    }
+
+    // Grows the table ahead of one more element when it would go over the
+    // max load factor. Doubling keeps the cost of growing constant per
+    // insert on average. Returns whether the buckets changed.
+    bool _grow_for_insert() {
+        if (_size + 1 <= _max_load_factor * _bucket_count) {
+            return false;
+        }
+        size_type needed = _buckets_for(_size + 1);
+        rehash(needed > _bucket_count * 2 ? needed : _bucket_count * 2);
+        return true;
+    }
+
 public:
     explicit UnorderedMap(size_type bucket_count, const Hash & hash = Hash { },
-                const key_equal & equal = key_equal { }): _head() {
-                    _hash = hash;
-                    _equal = equal;
-                    _bucket_count = next_greater_prime(bucket_count);
+                const key_equal & equal = key_equal { }): _head(), _hash(hash), _equal(equal) {
+                    _bucket_count = BucketPolicy::bucket_count(bucket_count);
                     _buckets = new HashNode *[_bucket_count]();
                     _size = 0;
     }
@@ -250,23 +341,19 @@ public:
         clear();
     }
 
-    UnorderedMap(const UnorderedMap & other) {
+    UnorderedMap(const UnorderedMap & other) : _head(), _hash(other._hash), _equal(other._equal) {
         _buckets = new HashNode*[other._bucket_count]{};
-        _hash = other._hash;
         _size = 0;
         _bucket_count = other._bucket_count;
-        _equal = other._equal;
-        HashNode* hold = other._head.next;
-        while (hold != nullptr) {
-            insert(hold->val);
-            hold = hold->next;
-        }
+        _max_load_factor = other._max_load_factor;
+        _copy_nodes(other);
     }
 
     UnorderedMap(UnorderedMap && other) {
         _buckets = other._buckets;
         _size = other._size;
         _bucket_count = other._bucket_count;
+        _max_load_factor = other._max_load_factor;
         _hash = other._hash;
         _equal = other._equal;
         _head.next = other._head.next;
@@ -276,7 +363,7 @@ public:
         other._buckets = new HashNode* [other._bucket_count]{};
         other._head.next = nullptr;
         if (_head.next != nullptr) {
-            _buckets[_bucket(_head.next->val.first)] = &_head;
+            _buckets[_bucket(_head.next->code)] = &_head;
         }
     }
 
@@ -290,12 +377,9 @@ public:
         _hash = other._hash;
         _size = 0;
         _bucket_count = other._bucket_count;
+        _max_load_factor = other._max_load_factor;
         _equal = other._equal;
-        HashNode* hold = other._head.next;
-        while (hold != nullptr) {
-            insert(hold->val);
-            hold = hold->next;
-        }
+        _copy_nodes(other);
         return *this;
     }
 
@@ -309,6 +393,7 @@ public:
         _buckets = other._buckets;
         _size = other._size;
         _bucket_count = other._bucket_count;
+        _max_load_factor = other._max_load_factor;
         _hash = other._hash;
         _equal = other._equal;
         _head.next = other._head.next;
@@ -318,7 +403,7 @@ public:
         other._buckets = new HashNode* [other._bucket_count]{};
         other._head.next = nullptr;
         if (_head.next != nullptr) {
-            _buckets[_bucket(_head.next->val.first)] = &_head;
+            _buckets[_bucket(_head.next->code)] = &_head;
         }
         return *this;
     }
@@ -350,7 +435,7 @@ public:
         if (hold == nullptr) {
             return 0;
         }
-        while (hold->next && _bucket(hold->val.first) == _bucket(hold->next->val.first)) {
+        while (hold->next && _bucket(hold->code) == _bucket(hold->next->code)) {
             hold = hold->next;
             count++;
         }
@@ -359,67 +444,198 @@ public:
 
     float load_factor() const { return float(_size)/float(_bucket_count); }
 
-    size_type bucket(const Key & key) const { return _bucket(key); }
+    float max_load_factor() const noexcept { return _max_load_factor; }
+
+    // Sets the load factor that inserts grow the table to stay under, and
+    // grows it right away if it is already over
+    void max_load_factor(float ml) {
+        if (!(ml > 0)) {
+            throw std::invalid_argument("max_load_factor must be positive");
+        }
+        _max_load_factor = ml;
+        if (load_factor() > _max_load_factor) {
+            rehash(0);
+        }
+    }
+
+    // Moves to the policy's bucket count for count buckets, or for what
+    // the current size needs if that is more (the next prime by default).
+    // The nodes are relinked into the new buckets where they are; none is
+    // allocated or copied.
+    void rehash(size_type count) {
+        size_type needed = _buckets_for(_size);
+        size_type new_count = BucketPolicy::bucket_count(count > needed ? count : needed);
+        if (new_count == _bucket_count) {
+            return;
+        }
+        HashNode** new_buckets = new HashNode*[new_count]();
+
+        // rebuild the node list one node at a time, each going to the
+        // front of its bucket, or to the front of the list if its bucket
+        // is new, as _insert_before does
+        HashNode* node = _head.next;
+        _head.next = nullptr;
+        size_type first_bucket = 0;
+        while (node != nullptr) {
+            HashNode* next = node->next;
+            size_type bucket = _range_hash(node->code, new_count);
+            if (new_buckets[bucket] == nullptr) {
+                node->next = _head.next;
+                _head.next = node;
+                new_buckets[bucket] = &_head;
+                if (node->next != nullptr) {
+                    new_buckets[first_bucket] = node;
+                }
+                first_bucket = bucket;
+            }
+            else {
+                node->next = new_buckets[bucket]->next;
+                new_buckets[bucket]->next = node;
+            }
+            node = next;
+        }
+
+        delete[] _buckets;
+        _buckets = new_buckets;
+        _bucket_count = new_count;
+    }
+
+    // Makes room for count elements without going over the max load
+    // factor. With no max load factor, count buckets are reserved instead.
+    // The table never shrinks.
+    void reserve(size_type count) {
+        size_type needed = std::isinf(_max_load_factor) ? count : _buckets_for(count);
+        if (needed > _bucket_count) {
+            rehash(needed);
+        }
+    }
+
+    size_type bucket(const Key & key) const { return _bucket(_hash(key)); }
 
     std::pair<iterator, bool> insert(value_type && value) {
-        size_t _code = _hash((value.first));
-        size_t __bucket = _bucket(_code);
-        HashNode* _temp = _find_prev(_code, __bucket, value.first);
-        if (_temp) {
-            return std::make_pair(iterator(_temp->next), false);
+        Lookup lookup = _lookup(value.first);
+        if (lookup.prev) {
+            return std::make_pair(iterator(lookup.prev->next), false);
         }
-        HashNode* temp = new HashNode(std::move(value));
-        _insert_before(__bucket, temp);
-        iterator hold = iterator(temp);
-        return std::make_pair(hold, true);
+        return std::make_pair(_emplace_new(lookup, std::move(value)), true);
     }
 
     std::pair<iterator, bool> insert(const value_type & value) {
-        size_t _code = _hash(value.first);
-        size_t __bucket = _bucket(_code);
-        HashNode* _temp = _find_prev(_code, __bucket, value.first);
-        if (_temp) {
-            return std::make_pair(iterator(_temp->next), false);
+        Lookup lookup = _lookup(value.first);
+        if (lookup.prev) {
+            return std::make_pair(iterator(lookup.prev->next), false);
         }
-        HashNode* temp = new HashNode(value);
-        _insert_before(__bucket, temp);
-        iterator hold = iterator(temp);
-        return std::make_pair(hold, true);
+        return std::make_pair(_emplace_new(lookup, value), true);
+    }
+
+    // Inserts key with a value built from args only if key is missing;
+    // otherwise args are left alone
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key & key, Args &&... args) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            return std::make_pair(iterator(lookup.prev->next), false);
+        }
+        return std::make_pair(_emplace_new(lookup, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)), true);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key && key, Args &&... args) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            return std::make_pair(iterator(lookup.prev->next), false);
+        }
+        return std::make_pair(_emplace_new(lookup, std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...)), true);
+    }
+
+    // Assigns obj to key's value, inserting key if it is missing
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key & key, M && obj) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            lookup.prev->next->val.second = std::forward<M>(obj);
+            return std::make_pair(iterator(lookup.prev->next), false);
+        }
+        return std::make_pair(_emplace_new(lookup, key, std::forward<M>(obj)), true);
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key && key, M && obj) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            lookup.prev->next->val.second = std::forward<M>(obj);
+            return std::make_pair(iterator(lookup.prev->next), false);
+        }
+        return std::make_pair(_emplace_new(lookup, std::move(key), std::forward<M>(obj)), true);
     }
 
     iterator find(const Key & key) {
-        if (_find_prev(key)) {
-            return iterator(_find_prev(key)->next);
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            return iterator(lookup.prev->next);
         }
         return end();
     }
 
     T& operator[](const Key & key) {
-        if (find(key) == end()) {
-            HashNode* temp = new HashNode(std::make_pair(key, mapped_type()));
-            _insert_before(_bucket(key), temp);
-        }
-        return find(key)._node->val.second;
+        return try_emplace(key).first->second;
     }
 
+    T& operator[](Key && key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // The node before pos is found by address from the start of its
+    // bucket; the key is neither hashed nor compared
     iterator erase(iterator pos) {
-        HashNode* prev = _find_prev(pos._node->val.first);
-        if (prev == nullptr) {
-            return iterator(nullptr);
-        }
+        HashNode* prev = _prev_of(pos._node);
         _erase_after(prev);
         return iterator(prev->next);
     }
 
     size_type erase(const Key & key) {
-        iterator hold = find(key);
-        if (hold == iterator(nullptr)) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev == nullptr) {
             return 0;
         }
-        else {
-            erase(hold);
-            return 1;
+        _erase_after(lookup.prev);
+        return 1;
+    }
+
+    // Lookups by any key type K the hash and predicate both take, such as
+    // a std::string_view or const char* for std::string keys, without
+    // building a Key. Only there when both declare is_transparent.
+
+    template <typename K, typename H = Hash, typename = unordered_map_detail::if_transparent<H, Pred>>
+    iterator find(const K & key) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            return iterator(lookup.prev->next);
+        }
+        return end();
+    }
+
+    // A Key is built from key only when it is inserted
+    template <typename K, typename H = Hash, typename = unordered_map_detail::if_transparent<H, Pred>>
+    T& operator[](const K & key) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev) {
+            return lookup.prev->next->val.second;
+        }
+        return _emplace_new(lookup, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple())->second;
+    }
+
+    template <typename K, typename H = Hash, typename = unordered_map_detail::if_transparent<H, Pred>>
+    size_type erase(const K & key) {
+        Lookup lookup = _lookup(key);
+        if (lookup.prev == nullptr) {
+            return 0;
         }
+        _erase_after(lookup.prev);
+        return 1;
     }
 
     template<typename KK, typename VV>
@@ -453,7 +669,7 @@ void print_map(const UnorderedMap<K, V> & map, std::ostream & os = std::cout) {
         if(!node) {
             os << "(nullptr)";
         } else {
-            while((node = node->next) && map.bucket(node->val.first) == bucket) {
+            while((node = node->next) && map._bucket(node->code) == bucket) {
                 os << "(" << node->val.first << ", " << node->val.second << ") ";
             }
         }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>  // std::sample
+#include <cctype>     // std::toupper
+#include <filesystem> // std::filesystem::path
+#include <fstream>    // std::ifstream
+#include <functional> // std::hash
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The hashes main.cpp compares, and the "Adjective Animal" keys it fills
+// the map with, shared with the benchmarks.
+//
+// The hashes take a std::string_view, so a std::string, string_view or
+// string literal hashes the same without a copy, and declare
+// is_transparent so a map with a transparent predicate (std::equal_to<>)
+// can be searched by any of them.
+
+struct zero_hash {
+    using is_transparent = void;
+
+    size_t operator() (std::string_view str) const {
+        return 0;
+    }
+};
+
+struct first_character_hash  {
+    using is_transparent = void;
+
+    size_t operator() (std::string_view str) const {
+        if(str.length() == 0)
+            return 0ull;
+
+        return str[0];
+    }
+};
+
+struct polynomial_rolling_hash {
+    using is_transparent = void;
+
+    size_t operator() (std::string_view str) const {
+        const int b = 19;
+        const size_t m = 3298534883309ul;
+        
+        size_t hash = 0;
+        size_t pow = 1;
+
+        for(size_t i = 0; i < str.length(); i++) {
+            hash += str[i] * pow;
+            pow =  (pow * b) % m;
+        }
+
+        return hash;
+    }
+};
+
+enum class HashType {
+    ZERO,
+    FIRST_CHARACTER,
+    POLYNOMIAL_ROLLING,
+    STD
+};
+
+struct hash_selector {
+    zero_hash _zero_hash;
+    first_character_hash _first_char_hash;
+    polynomial_rolling_hash _poly_rolling_hash;
+    // equal to std::hash<std::string> on the same characters
+    std::hash<std::string_view> _std_hash;
+    HashType _htype;
+
+    public:
+
+    using is_transparent = void;
+
+    hash_selector(HashType htype) 
+        : _htype(htype)
+    {}
+
+    size_t operator() (std::string_view str) const {
+        switch(_htype) {
+            case HashType::ZERO:
+                return _zero_hash(str);
+            case HashType::FIRST_CHARACTER:
+                return _first_char_hash(str);
+            case HashType::POLYNOMIAL_ROLLING:
+                return _poly_rolling_hash(str);
+            case HashType::STD:
+                return _std_hash(str);
+        }
+
+        return 0;
+    }
+};
+
+namespace fs = std::filesystem;
+
+class AnimalDistribution {
+    std::vector<std::string> animals;
+    std::vector<std::string> adjectives;
+
+    public:
+    
+    AnimalDistribution(fs::path const adjectives_path, fs::path const animals_path) {
+        std::ifstream adjectives_file(adjectives_path);
+        std::ifstream animals_file(animals_path);
+
+        std::string line;
+
+        while(std::getline(adjectives_file, line))
+            adjectives.push_back(line);
+        
+        while(std::getline(animals_file, line))
+            animals.push_back(line);
+    }
+
+    template<class Generator>
+    std::string operator()(Generator & g) const {
+        std::string animal, adjective;
+
+        std::sample(adjectives.cbegin(), adjectives.cend(), &adjective, 1, g);
+        std::sample(animals.cbegin(), animals.cend(), &animal, 1, g);
+
+        adjective[0] = std::toupper(adjective[0]);
+        
+        return adjective + " " + animal;
+    }
+
+};
@@ -1,4 +1,5 @@
 #include "UnorderedMap.h"
+#include "animals.h"
 
 #include <random>
 #include <limits>
@@ -19,74 +20,6 @@ static void print_sep() {
     std::cout << std::endl << std::endl;
 }
 
-struct zero_hash {
-    size_t operator() (std::string const & str) const {
-        return 0;
-    }
-};
-
-struct first_character_hash  {
-    size_t operator() (std::string const & str) const {
-        if(str.length() == 0)
-            return 0ull;
-
-        return str[0];
-    }
-};
-
-struct polynomial_rolling_hash {
-    size_t operator() (std::string const & str) const {
-        const int b = 19;
-        const size_t m = 3298534883309ul;
-        
-        size_t hash = 0;
-        size_t pow = 1;
-
-        for(size_t i = 0; i < str.length(); i++) {
-            hash += str[i] * pow;
-            pow =  (pow * b) % m;
-        }
-
-        return hash;
-    }
-};
-
-enum class HashType {
-    ZERO,
-    FIRST_CHARACTER,
-    POLYNOMIAL_ROLLING,
-    STD
-};
-
-struct hash_selector {
-    zero_hash _zero_hash;
-    first_character_hash _first_char_hash;
-    polynomial_rolling_hash _poly_rolling_hash;
-    std::hash<std::string> _std_hash;
-    HashType _htype;
-
-    public:
-
-    hash_selector(HashType htype) 
-        : _htype(htype)
-    {}
-
-    size_t operator() (std::string const & str) const {
-        switch(_htype) {
-            case HashType::ZERO:
-                return _zero_hash(str);
-            case HashType::FIRST_CHARACTER:
-                return _first_char_hash(str);
-            case HashType::POLYNOMIAL_ROLLING:
-                return _poly_rolling_hash(str);
-            case HashType::STD:
-                return _std_hash(str);
-        }
-
-        return 0;
-    }
-};
-
 HashType prompt_hash_type() {
     using std::cin, std::cout, std::endl, std::ios;
 
@@ -141,41 +74,6 @@ HashType prompt_hash_type() {
     return choices[choice].type;
 }
 
-namespace fs = std::filesystem;
-
-class AnimalDistribution {
-    std::vector<std::string> animals;
-    std::vector<std::string> adjectives;
-
-    public:
-    
-    AnimalDistribution(fs::path const adjectives_path, fs::path const animals_path) {
-        std::ifstream adjectives_file(adjectives_path);
-        std::ifstream animals_file(animals_path);
-
-        std::string line;
-
-        while(std::getline(adjectives_file, line))
-            adjectives.push_back(line);
-        
-        while(std::getline(animals_file, line))
-            animals.push_back(line);
-    }
-
-    template<class Generator>
-    std::string operator()(Generator & g) const {
-        std::string animal, adjective;
-
-        std::sample(adjectives.cbegin(), adjectives.cend(), &adjective, 1, g);
-        std::sample(animals.cbegin(), animals.cend(), &animal, 1, g);
-
-        adjective[0] = std::toupper(adjective[0]);
-        
-        return adjective + " " + animal;
-    }
-
-};
-
 constexpr size_t N_SAMPLE_HASHES = 5;
 
 int main() {
@@ -200,7 +98,11 @@ int main() {
         std::cout << animal << ": " << hash(animal) << std::endl;
     }
 
-    UnorderedMap<std::string, int, hash_selector> map(30, hash);
+    // std::equal_to<> with the transparent hash_selector lets the map be
+    // searched by std::string_view or string literals
+    UnorderedMap<std::string, int, hash_selector, std::equal_to<>> map(30, hash);
+    // grow past the initial 30 buckets to keep chains short
+    map.max_load_factor(1.0f);
 
     for(size_t i = 0; i < N_ELEMENTS; i++) {
         map.insert({distribution(generator), 0});
@@ -224,19 +126,27 @@ int main() {
         load_variance /= map.size() - 1;
     }
 
+    // how many buckets hold chains of each length; with the table growing
+    // there are too many buckets to draw one bar each
+    std::vector<size_t> chain_lengths(max_count + 1);
+    for(size_t size : bucket_sizes) {
+        chain_lengths[size]++;
+    }
+    size_t max_buckets = *std::max_element(chain_lengths.cbegin(), chain_lengths.cend());
+
     print_sep();
 
-    for(size_t bucket = 0; bucket < map.bucket_count(); bucket++) {
-        std::cout << std::setw(5) << bucket << ": ";
+    for(size_t length = 0; length <= max_count; length++) {
+        std::cout << std::setw(5) << length << ": ";
         
         size_t width = MAX_TERMINAL_WIDTH * 
-            (static_cast<float>(bucket_sizes[bucket]) / static_cast<float>(max_count));
+            (static_cast<float>(chain_lengths[length]) / static_cast<float>(max_buckets));
     
         for(size_t i = 0; i < width; i++) {
             std::cout << "#";
         }
 
-        std::cout << std::endl;
+        std::cout << " " << chain_lengths[length] << std::endl;
     }
 
     print_sep();
@@ -244,6 +154,7 @@ int main() {
     std::cout << "  Size: " << map.size() << std::endl;
     std::cout << "  Buckets: " << map.bucket_count() << std::endl;
     std::cout << "  Load factor: " << map.load_factor() << std::endl;
+    std::cout << "  Longest chain: " << max_count << std::endl;
     std::cout << "  Load variance: " << load_variance << std::endl;
 
     return 0;
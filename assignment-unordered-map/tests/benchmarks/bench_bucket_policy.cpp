@@ -0,0 +1,98 @@
+// The three bucket policies against each other, with a max load factor of
+// 1. Integer keys hash to themselves, so reducing the code to a bucket is
+// a large share of each lookup; on "Adjective Animal" keys the string
+// hash and compare dominate. Times are ns per operation, and longest is
+// the longest chain, which shows whether a weak hash collapsed. Animal
+// keys are a tenth as many as integer keys.
+//
+// Usage: bench_bucket_policy [keys] [data directory]    (default 1,000,000 ../data_files)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "UnorderedMap.h"
+#include "animals.h"
+#include "bench_util.h"
+
+template <typename Policy, typename Key, typename Hash>
+static void run(const char * label, const char * policy, const std::vector<Key> & keys,
+        const std::vector<Key> & misses, const Hash & hash) {
+    UnorderedMap<Key, size_t, Hash, std::equal_to<Key>, Policy> map(30, hash);
+    map.max_load_factor(1.0f);
+    size_t sink = 0;
+
+    double insert = seconds([&]() {
+        for(const Key & key : keys)
+            map.insert({key, 1});
+    });
+    double hit = seconds([&]() {
+        for(const Key & key : keys)
+            sink += map.find(key)->second;
+    });
+    double miss = seconds([&]() {
+        for(const Key & key : misses)
+            sink += map.find(key) != map.end();
+    });
+
+    size_t longest = 0;
+    for(size_t b = 0; b < map.bucket_count(); b++)
+        longest = std::max(longest, map.bucket_size(b));
+
+    // keeps the lookups from being optimized out
+    if(sink == size_t(-1))
+        std::puts("");
+
+    double n = keys.size();
+    std::printf("%-16s %-12s %9zu %8.1f %8.1f %8.1f %8zu\n", label, policy, map.bucket_count(),
+        insert * 1e9 / n, hit * 1e9 / n, miss * 1e9 / n, longest);
+}
+
+template <typename Key, typename Hash>
+static void run_all(const char * label, const std::vector<Key> & keys,
+        const std::vector<Key> & misses, const Hash & hash) {
+    run<PrimeBuckets>(label, "prime", keys, misses, hash);
+    run<PowerOfTwoBuckets>(label, "power of 2", keys, misses, hash);
+    run<FastRangeBuckets>(label, "fast range", keys, misses, hash);
+}
+
+int main(int argc, char ** argv) {
+    size_t n_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    fs::path data_files = argc > 2 ? fs::path(argv[2]) : fs::path("..") / "data_files";
+
+    std::printf("%zu keys\n", n_keys);
+    std::printf("%-16s %-12s %9s %8s %8s %8s %8s\n", "keys", "policy", "buckets", "insert", "hit", "miss", "longest");
+
+    std::mt19937_64 generator(221);
+    {
+        std::vector<size_t> keys, misses;
+        for(size_t i = 0; i < n_keys; i++) {
+            keys.push_back(generator());
+            misses.push_back(generator());
+        }
+        run_all("random integer", keys, misses, std::hash<size_t>());
+
+        // sequential integers are the prime modulus's best case
+        for(size_t i = 0; i < n_keys; i++) {
+            keys[i] = i;
+            misses[i] = n_keys + i;
+        }
+        run_all("sequential", keys, misses, std::hash<size_t>());
+    }
+
+    std::vector<std::string> keys, misses;
+    AnimalKeys(data_files).draw(n_keys / 10, keys, misses);
+    run_all("animal, std", keys, misses, hash_selector(HashType::STD));
+    run_all("animal, poly", keys, misses, hash_selector(HashType::POLYNOMIAL_ROLLING));
+
+    // first_character_hash has a few dozen codes, so every policy ends up
+    // with chains of thousands; a tenth of the keys is enough to see it
+    keys.resize(keys.size() / 10);
+    misses.resize(misses.size() / 10);
+    run_all("animal, first", keys, misses, hash_selector(HashType::FIRST_CHARACTER));
+
+    return 0;
+}
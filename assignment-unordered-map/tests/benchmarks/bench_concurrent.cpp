@@ -0,0 +1,130 @@
+// Operations per second on one map shared by 1, 2, 4, ... threads, for an
+// UnorderedMap behind one global mutex and for a ConcurrentUnorderedMap,
+// whose 64 lock stripes let threads in different buckets run together.
+// Keys are "Adjective Animal" names, half of them in the map at the start.
+// The read-heavy mix is 90% find, 5% insert and 5% erase; the write-heavy
+// one is 10% find, 45% insert and 45% erase. Speedups are bounded by the
+// number of cores, which is printed first.
+//
+// Usage: bench_concurrent [ops] [max threads] [data directory]    (default 1,000,000 16 ../data_files)
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentUnorderedMap.h"
+#include "UnorderedMap.h"
+#include "animals.h"
+#include "bench_util.h"
+
+enum Op : uint8_t { FIND, INSERT, ERASE };
+
+struct Step {
+    uint32_t key;
+    Op op;
+};
+
+// What each thread will do, drawn up front so the timing leaves out the
+// random number generator
+static std::vector<std::vector<Step>> plan(size_t threads, size_t ops, size_t n_keys, unsigned find_percent) {
+    std::vector<std::vector<Step>> steps(threads);
+    for(size_t thread = 0; thread < threads; thread++) {
+        std::mt19937 generator(221 + thread);
+        std::uniform_int_distribution<uint32_t> key(0, n_keys - 1);
+        std::uniform_int_distribution<unsigned> percent(0, 99);
+        for(size_t i = 0; i < ops / threads; i++) {
+            unsigned p = percent(generator);
+            Op op = p < find_percent ? FIND : p % 2 ? INSERT : ERASE;
+            steps[thread].push_back({key(generator), op});
+        }
+    }
+    return steps;
+}
+
+// apply does one step and returns whether it found a key; each thread
+// keeps its own count, so the threads share nothing but the map
+template <typename Map, typename Apply>
+static double ops_per_second(const std::vector<std::string> & keys, const std::vector<std::vector<Step>> & steps,
+                             std::atomic<size_t> & found, Map & map, Apply apply) {
+    for(size_t k = 0; k < keys.size(); k += 2)
+        apply(map, Step{uint32_t(k), INSERT});
+
+    size_t ops = 0;
+    double elapsed = seconds([&]() {
+        std::vector<std::thread> threads;
+        for(const std::vector<Step> & mine : steps) {
+            ops += mine.size();
+            threads.emplace_back([&]() {
+                size_t hits = 0;
+                for(const Step & step : mine)
+                    hits += apply(map, step);
+                found += hits;
+            });
+        }
+        for(std::thread & thread : threads)
+            thread.join();
+    });
+    return ops / elapsed;
+}
+
+int main(int argc, char ** argv) {
+    size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    fs::path data_files = argc > 3 ? fs::path(argv[3]) : fs::path("..") / "data_files";
+
+    AnimalKeys animal_keys(data_files);
+    std::vector<std::string> keys(50000);
+    for(std::string & key : keys)
+        key = animal_keys();
+
+    std::printf("%zu ops, %zu keys, %u cores, Mops/s\n", ops, keys.size(), std::thread::hardware_concurrency());
+    std::printf("%-12s %8s %14s %14s %8s\n", "mix", "threads", "global mutex", "striped", "speedup");
+
+    std::atomic<size_t> found { 0 };
+    for(unsigned find_percent : {90u, 10u}) {
+        for(size_t threads = 1; threads <= max_threads; threads *= 2) {
+            std::vector<std::vector<Step>> steps = plan(threads, ops, keys.size(), find_percent);
+
+            UnorderedMap<std::string, int, hash_selector> locked(30, hash_selector(HashType::STD));
+            locked.max_load_factor(1.0f);
+            std::mutex mutex;
+            double global = ops_per_second(keys, steps, found, locked, [&](auto & map, Step step) {
+                const std::string & key = keys[step.key];
+                std::lock_guard<std::mutex> lock(mutex);
+                if(step.op == FIND)
+                    return map.find(key) != map.end();
+                if(step.op == INSERT)
+                    map.insert({key, 1});
+                else
+                    map.erase(key);
+                return false;
+            });
+
+            ConcurrentUnorderedMap<std::string, int, hash_selector> shared(30, hash_selector(HashType::STD));
+            double striped = ops_per_second(keys, steps, found, shared, [&](auto & map, Step step) {
+                const std::string & key = keys[step.key];
+                if(step.op == FIND)
+                    return map.contains(key);
+                if(step.op == INSERT)
+                    map.insert({key, 1});
+                else
+                    map.erase(key);
+                return false;
+            });
+
+            std::printf("%-12s %8zu %14.2f %14.2f %8.2f\n", find_percent == 90 ? "read-heavy" : "write-heavy",
+                        threads, global / 1e6, striped / 1e6, striped / global);
+        }
+    }
+    // keeps the lookups from being optimized out
+    if(found == size_t(-1))
+        std::puts("");
+
+    return 0;
+}
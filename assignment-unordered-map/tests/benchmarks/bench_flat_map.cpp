@@ -0,0 +1,90 @@
+// FlatUnorderedMap against UnorderedMap and std::unordered_map on
+// "Adjective Animal" keys hashed with std::hash, from 1K to 1M keys. Each
+// map starts at 30 buckets and grows to its default max load factor,
+// except UnorderedMap, whose default is not to grow, so it is set to 1 as
+// std::unordered_map's is. Times are ns per operation:
+//
+//   insert   insert every key (some repeat)
+//   hit      find every inserted key
+//   miss     find keys that are not there
+//   iterate  visit every element
+//   erase    erase every key by value
+//
+// Usage: bench_flat_map [max keys] [data directory]    (default 1,000,000 ../data_files)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FlatUnorderedMap.h"
+#include "UnorderedMap.h"
+#include "animals.h"
+#include "bench_util.h"
+
+template <typename Map>
+static void run(const char * label, Map & map,
+        const std::vector<std::string> & keys, const std::vector<std::string> & misses) {
+    size_t sink = 0;
+
+    double insert = seconds([&]() {
+        for(const std::string & key : keys)
+            map.insert({key, 1});
+    });
+    double hit = seconds([&]() {
+        for(const std::string & key : keys)
+            sink += map.find(key)->second;
+    });
+    double miss = seconds([&]() {
+        for(const std::string & key : misses)
+            sink += map.find(key) != map.end();
+    });
+    double iterate = seconds([&]() {
+        for(auto & pair : map)
+            sink += pair.second;
+    });
+    size_t size = map.size();
+    double erase = seconds([&]() {
+        for(const std::string & key : keys)
+            sink += map.erase(key);
+    });
+
+    // keeps the work from being optimized out
+    if(sink == size_t(-1))
+        std::puts("");
+
+    double n = keys.size();
+    std::printf("%8zu %-20s %8.1f %8.1f %8.1f %8.1f %8.1f\n", keys.size(), label,
+        insert * 1e9 / n, hit * 1e9 / n, miss * 1e9 / n, iterate * 1e9 / size, erase * 1e9 / n);
+}
+
+int main(int argc, char ** argv) {
+    size_t max_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    fs::path data_files = argc > 2 ? fs::path(argv[2]) : fs::path("..") / "data_files";
+
+    AnimalKeys animal_keys(data_files);
+
+    std::printf("%8s %-20s %8s %8s %8s %8s %8s\n", "keys", "map", "insert", "hit", "miss", "iterate", "erase");
+
+    for(size_t n = 1000; n <= max_keys; n *= 10) {
+        std::vector<std::string> keys, misses;
+        animal_keys.draw(n, keys, misses);
+
+        {
+            FlatUnorderedMap<std::string, int> map(30);
+            run("FlatUnorderedMap", map, keys, misses);
+        }
+        {
+            UnorderedMap<std::string, int> map(30);
+            map.max_load_factor(1.0f);
+            run("UnorderedMap", map, keys, misses);
+        }
+        {
+            std::unordered_map<std::string, int> map(30);
+            run("std::unordered_map", map, keys, misses);
+        }
+    }
+
+    return 0;
+}
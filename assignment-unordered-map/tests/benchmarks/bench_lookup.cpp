@@ -0,0 +1,72 @@
+// Nanoseconds per find on "Adjective Animal" keys, for each of main.cpp's
+// hashes. Hits look up every key in the map, misses look up keys that are
+// not. The table is either main.cpp's fixed 30 buckets, where chains run
+// hundreds of nodes long, or grown to a load factor of at most 1.
+//
+// Usage: bench_lookup [keys] [data directory]    (default 10,000 ../data_files)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "UnorderedMap.h"
+#include "animals.h"
+#include "bench_util.h"
+
+using Map = UnorderedMap<std::string, int, hash_selector>;
+
+// Runs every lookup at least 3 times and for at least 0.2s
+static double ns_per_find(Map & map, const std::vector<std::string> & keys) {
+    size_t found = 0, finds = 0;
+    double total = 0;
+    for(size_t round = 0; round < 3 || total < 0.2; round++) {
+        total += seconds([&]() {
+            for(const std::string & key : keys)
+                found += map.find(key) != map.end();
+        });
+        finds += keys.size();
+    }
+    // keeps the lookups from being optimized out
+    if(found == size_t(-1))
+        std::puts("");
+    return total * 1e9 / finds;
+}
+
+int main(int argc, char ** argv) {
+    size_t n_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    fs::path data_files = argc > 2 ? fs::path(argv[2]) : fs::path("..") / "data_files";
+
+    std::vector<std::string> hits, misses;
+    AnimalKeys(data_files).draw(n_keys, hits, misses);
+
+    struct Choice {
+        const char * label;
+        HashType type;
+    };
+    const Choice choices[] = {
+        {"first character", HashType::FIRST_CHARACTER},
+        {"polynomial", HashType::POLYNOMIAL_ROLLING},
+        {"std", HashType::STD},
+    };
+
+    std::printf("%zu keys, ns per find\n", n_keys);
+    std::printf("%-16s %8s %8s %10s %10s\n", "hash", "buckets", "load", "hit", "miss");
+
+    for(const Choice & choice : choices) {
+        for(bool grow : {false, true}) {
+            Map map(30, hash_selector(choice.type));
+            if(grow)
+                map.max_load_factor(1.0f);
+            for(const std::string & key : hits)
+                map.insert({key, 0});
+
+            double hit = ns_per_find(map, hits);
+            double miss = ns_per_find(map, misses);
+            std::printf("%-16s %8zu %8.1f %10.1f %10.1f\n", choice.label,
+                map.bucket_count(), map.load_factor(), hit, miss);
+        }
+    }
+
+    return 0;
+}
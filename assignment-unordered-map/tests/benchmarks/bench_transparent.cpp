@@ -0,0 +1,67 @@
+// Finding "Adjective Animal" keys that arrive as const char*, with the
+// map's default predicate, which builds a std::string for every find, and
+// with std::equal_to<>, which lets find take a std::string_view. Names
+// over 15 characters do not fit std::string's inline buffer, so their
+// temporaries allocate. Times are ns per find, load factor <= 1.
+//
+// Usage: bench_transparent [keys] [data directory]    (default 100,000 ../data_files)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "UnorderedMap.h"
+#include "animals.h"
+#include "bench_util.h"
+
+template <typename Pred, typename Lookup>
+static double ns_per_find(HashType type, const std::vector<std::string> & keys, Lookup lookup) {
+    UnorderedMap<std::string, int, hash_selector, Pred> map(30, hash_selector(type));
+    map.max_load_factor(1.0f);
+    for(const std::string & key : keys)
+        map.insert({key, 1});
+
+    size_t found = 0;
+    double best = 1e9;
+    for(size_t round = 0; round < 5; round++) {
+        best = std::min(best, seconds([&]() {
+            for(const std::string & key : keys)
+                found += lookup(map, key.c_str()) != map.end();
+        }));
+    }
+    // keeps the lookups from being optimized out
+    if(found == size_t(-1))
+        std::puts("");
+    return best * 1e9 / keys.size();
+}
+
+int main(int argc, char ** argv) {
+    size_t n_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    fs::path data_files = argc > 2 ? fs::path(argv[2]) : fs::path("..") / "data_files";
+
+    AnimalKeys animal_keys(data_files);
+    std::vector<std::string> keys;
+    size_t long_keys = 0;
+    for(size_t i = 0; i < n_keys; i++) {
+        keys.push_back(animal_keys());
+        long_keys += keys.back().size() > 15;
+    }
+
+    std::printf("%zu keys, %.0f%% longer than 15 characters, ns per find\n", n_keys, 100.0 * long_keys / n_keys);
+    std::printf("%-12s %14s %14s\n", "hash", "std::string", "string_view");
+
+    for(HashType type : {HashType::POLYNOMIAL_ROLLING, HashType::STD}) {
+        double temporary = ns_per_find<std::equal_to<std::string>>(type, keys, [](auto & map, const char * key) {
+            return map.find(key);
+        });
+        double view = ns_per_find<std::equal_to<>>(type, keys, [](auto & map, const char * key) {
+            return map.find(std::string_view(key));
+        });
+        std::printf("%-12s %14.1f %14.1f\n", type == HashType::STD ? "std" : "polynomial", temporary, view);
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// What the UnorderedMap benchmarks share
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "animals.h"
+
+// Wall time of one call to func
+template <typename Func>
+static double seconds(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// "Adjective Animal" keys from the word lists in data_files, in the same
+// order on every run
+class AnimalKeys {
+    AnimalDistribution _distribution;
+    std::mt19937 _generator;
+
+    public:
+
+    explicit AnimalKeys(const fs::path & data_files)
+        : _distribution(data_files / "adjectives.txt", data_files / "animals.txt"), _generator(221) { }
+
+    std::string operator()() { return _distribution(_generator); }
+
+    // Adds n keys to keys, and n to misses that none of them can equal
+    void draw(size_t n, std::vector<std::string> & keys, std::vector<std::string> & misses) {
+        for(size_t i = 0; i < n; i++) {
+            keys.push_back((*this)());
+            misses.push_back((*this)() + " Jr.");
+        }
+    }
+};
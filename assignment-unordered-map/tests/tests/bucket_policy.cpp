@@ -0,0 +1,84 @@
+#include "executable.h"
+
+#include <unordered_map>
+
+// Codes that differ only in their high bits, which a plain mask or
+// multiply-shift would send to one bucket
+struct high_bits_hash {
+    size_t operator()(size_t key) const {
+        return key << 40;
+    }
+};
+
+template<typename Policy>
+static bool policy_operations(Typegen & t) {
+    using Map = UnorderedMap<size_t, size_t, std::hash<size_t>, std::equal_to<size_t>, Policy>;
+
+    size_t n = t.range<size_t>(0, 100);
+    Map map(n);
+    if(map.bucket_count() != Policy::bucket_count(n) || map.bucket_count() < n)
+        return false;
+    map.max_load_factor(t.range(1, 4) / 2.0f);
+
+    std::unordered_map<size_t, size_t> gt;
+    for(size_t k = t.range<size_t>(1, 2000); k > 0; k--) {
+        size_t key = t.range<size_t>(0, 1000);
+        if(t.range(3) == 0) {
+            if(map.erase(key) != gt.erase(key))
+                return false;
+        }
+        else {
+            map[key] += k;
+            gt[key] += k;
+        }
+    }
+    if(map.size() != gt.size() || map.load_factor() > map.max_load_factor())
+        return false;
+
+    // every element sits in the bucket the policy gives its code
+    size_t count = 0;
+    for(size_t b = 0; b < map.bucket_count(); b++) {
+        for(auto it = map.begin(b); it != map.end(b); it++) {
+            if(Policy::index(std::hash<size_t>{}(it->first), map.bucket_count()) != b)
+                return false;
+            if(map.bucket(it->first) != b || gt.at(it->first) != it->second)
+                return false;
+            count++;
+        }
+    }
+    return count == gt.size();
+}
+
+TEST(bucket_policy) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        ASSERT_TRUE(policy_operations<PrimeBuckets>(t));
+        ASSERT_TRUE(policy_operations<PowerOfTwoBuckets>(t));
+        ASSERT_TRUE(policy_operations<FastRangeBuckets>(t));
+    }
+
+    for(size_t n : {0ul, 1ul, 2ul, 3ul, 64ul, 65ul, 1000ul}) {
+        size_t count = PowerOfTwoBuckets::bucket_count(n);
+        ASSERT_TRUE(count >= n && count >= 2);
+        ASSERT_EQ(0ULL, count & (count - 1));
+        ASSERT_TRUE(count / 2 < n || count == 2);
+    }
+}
+
+template<typename Policy>
+static size_t longest_chain() {
+    UnorderedMap<size_t, size_t, high_bits_hash, std::equal_to<size_t>, Policy> map(1024);
+    for(size_t key = 0; key < 1024; key++)
+        map.insert({key, key});
+
+    size_t longest = 0;
+    for(size_t b = 0; b < map.bucket_count(); b++)
+        longest = std::max(longest, map.bucket_size(b));
+    return longest;
+}
+
+TEST(bucket_policy_mixing) {
+    // 1024 keys in 1024 buckets; unmixed, all would share a bucket
+    ASSERT_LT(longest_chain<PowerOfTwoBuckets>(), 16ULL);
+    ASSERT_LT(longest_chain<FastRangeBuckets>(), 16ULL);
+}
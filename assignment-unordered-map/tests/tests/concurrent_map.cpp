@@ -0,0 +1,195 @@
+#include "executable.h"
+
+#include "ConcurrentUnorderedMap.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Runs body(thread) on n threads and waits for them all
+template <typename Body>
+static void run_threads(size_t n, Body body) {
+    std::vector<std::thread> threads;
+    for(size_t thread = 0; thread < n; thread++)
+        threads.emplace_back(body, thread);
+    for(std::thread & thread : threads)
+        thread.join();
+}
+
+TEST(concurrent_map) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = ConcurrentUnorderedMap<size_t, size_t>;
+
+        Map map(t.range<size_t>(1, 64), {}, {}, t.range<size_t>(1, 16));
+        std::unordered_map<size_t, size_t> gt;
+
+        // one thread behaves as an ordinary map
+        for(size_t op = t.range<size_t>(1, 2000); op > 0; op--) {
+            size_t key = t.range(300ULL);
+            size_t value = t.get<size_t>();
+            switch(t.range(5ULL)) {
+            case 0:
+                ASSERT_EQ(gt.insert({key, value}).second, map.insert({key, value}));
+                break;
+            case 1:
+                ASSERT_EQ(gt.insert_or_assign(key, value).second, map.insert_or_assign(key, value));
+                break;
+            case 2:
+                ASSERT_EQ(gt.erase(key), map.erase(key));
+                break;
+            case 3: {
+                bool inserted = map.insert_or_visit({key, 1}, [](auto & pair) { pair.second++; });
+                ASSERT_EQ(!gt.count(key), inserted);
+                gt[key]++;
+                break;
+            }
+            default: {
+                auto found = map.find(key);
+                ASSERT_EQ(gt.count(key), size_t(found.has_value()));
+                ASSERT_EQ(gt.count(key), size_t(map.contains(key)));
+                if(found)
+                    ASSERT_EQ(gt[key], *found);
+                break;
+            }
+            }
+            ASSERT_EQ(gt.size(), map.size());
+            ASSERT_TRUE(map.load_factor() <= map.max_load_factor());
+        }
+
+        size_t seen = 0;
+        map.for_each([&](const auto & pair) {
+            seen += gt.count(pair.first) && gt[pair.first] == pair.second;
+        });
+        ASSERT_EQ(gt.size(), seen);
+
+        ASSERT_TRUE(map.visit(gt.empty() ? 0 : gt.begin()->first, [](auto & pair) { pair.second = 0; }) == !gt.empty());
+        ASSERT_FALSE(map.visit(300, [](auto &) {}));
+
+        map.clear();
+        ASSERT_TRUE(map.empty());
+        ASSERT_FALSE(map.contains(gt.empty() ? 0 : gt.begin()->first));
+    }
+}
+
+TEST(concurrent_map_rehash) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        ConcurrentUnorderedMap<size_t, size_t> map(t.range<size_t>(1, 64));
+        size_t n = t.range<size_t>(1, 1000);
+        for(size_t key = 0; key < n; key++)
+            map.insert({key, key});
+
+        // inserts grow the table to stay under the max load factor
+        ASSERT_TRUE(map.load_factor() <= 1.0f);
+
+        size_t count = t.range<size_t>(1, 2000);
+        map.rehash(count);
+        ASSERT_TRUE(map.bucket_count() >= count);
+        ASSERT_TRUE(map.load_factor() <= 1.0f);
+
+        map.max_load_factor(0.25f);
+        ASSERT_TRUE(map.load_factor() <= 0.25f);
+        map.reserve(4 * n);
+        ASSERT_TRUE(map.bucket_count() >= 16 * n);
+        size_t bucket_count = map.bucket_count();
+        map.reserve(1);
+        ASSERT_EQ(bucket_count, map.bucket_count());
+
+        for(size_t key = 0; key < n; key++)
+            ASSERT_EQ(key, *map.find(key));
+        ASSERT_EQ(n, map.size());
+    }
+
+    ConcurrentUnorderedMap<size_t, size_t> map(10);
+    bool thrown = false;
+    try {
+        map.max_load_factor(0.0f);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
+
+TEST(concurrent_map_threads) {
+    Typegen t;
+    for(size_t i = 0; i < 10; i++) {
+        const size_t n_threads = t.range<size_t>(2, 9);
+        const size_t per_thread = t.range<size_t>(100, 2000);
+
+        // starting from one bucket, the inserts rehash the table many
+        // times while the other threads are in it
+        ConcurrentUnorderedMap<size_t, size_t> map(1, {}, {}, t.range<size_t>(1, 64));
+        std::atomic<size_t> wrong { 0 };
+
+        // each thread inserts its own keys and reads the others'
+        run_threads(n_threads, [&](size_t thread) {
+            for(size_t k = 0; k < per_thread; k++) {
+                size_t key = k * n_threads + thread;
+                if(!map.insert({key, key * 2}))
+                    wrong++;
+                auto found = map.find(key);
+                if(!found || *found != key * 2)
+                    wrong++;
+
+                auto other = map.find(k * n_threads + (thread + 1) % n_threads);
+                if(other && *other != 2 * (k * n_threads + (thread + 1) % n_threads))
+                    wrong++;
+            }
+        });
+        ASSERT_EQ(0ULL, wrong.load());
+        ASSERT_EQ(n_threads * per_thread, map.size());
+
+        // then erases its odd keys while a rehash runs alongside
+        run_threads(n_threads + 1, [&](size_t thread) {
+            if(thread == n_threads) {
+                map.rehash(4 * n_threads * per_thread);
+                return;
+            }
+            for(size_t k = 1; k < per_thread; k += 2)
+                if(map.erase(k * n_threads + thread) != 1)
+                    wrong++;
+        });
+        ASSERT_EQ(0ULL, wrong.load());
+        ASSERT_EQ(n_threads * ((per_thread + 1) / 2), map.size());
+
+        size_t seen = 0;
+        map.for_each([&](const auto & pair) {
+            seen += pair.first / n_threads % 2 == 0 && pair.second == pair.first * 2;
+        });
+        ASSERT_EQ(map.size(), seen);
+    }
+}
+
+TEST(concurrent_map_counting) {
+    Typegen t;
+    for(size_t i = 0; i < 10; i++) {
+        std::vector<std::string> words(t.range<size_t>(1, 100));
+        for(std::string & word : words)
+            word = t.get<std::string>(20);
+
+        const size_t n_threads = t.range<size_t>(2, 9);
+        const size_t rounds = t.range<size_t>(1, 50);
+
+        // every thread counts every word, so they all fight over the same
+        // keys, and no count may go missing
+        ConcurrentUnorderedMap<std::string, size_t> counts(1, {}, {}, 4);
+        run_threads(n_threads, [&](size_t) {
+            for(size_t round = 0; round < rounds; round++)
+                for(const std::string & word : words)
+                    counts.insert_or_visit({word, 1}, [](auto & pair) { pair.second++; });
+        });
+
+        std::unordered_map<std::string, size_t> gt;
+        for(const std::string & word : words)
+            gt[word] += n_threads * rounds;
+
+        ASSERT_EQ(gt.size(), counts.size());
+        for(const auto & pair : gt)
+            ASSERT_EQ(pair.second, *counts.find(pair.first));
+    }
+}
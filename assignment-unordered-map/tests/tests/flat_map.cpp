@@ -0,0 +1,186 @@
+#include "executable.h"
+#include "FlatUnorderedMap.h"
+
+#include <type_traits>
+#include <unordered_map>
+
+// Sends every key to one of a few homes, so probe runs get long
+struct clumping_hash {
+    size_t operator()(int key) const {
+        return std::hash<int>{}(key) % 5;
+    }
+};
+
+template<typename Map>
+static bool same_contents(const std::unordered_map<int, int> & gt, Map & map) {
+    if(gt.size() != map.size())
+        return false;
+
+    size_t count = 0;
+    for(auto it = map.begin(); it != map.end(); it++) {
+        auto found = gt.find(it->first);
+        if(found == gt.end() || found->second != it->second)
+            return false;
+        count++;
+    }
+    if(count != gt.size())
+        return false;
+
+    for(auto const & pair : gt) {
+        auto it = map.find(pair.first);
+        if(it == map.end() || it->second != pair.second)
+            return false;
+    }
+    return true;
+}
+
+template<typename Hash>
+static bool random_operations(Typegen & t) {
+    using Map = FlatUnorderedMap<int, int, Hash>;
+
+    Map map(t.range<size_t>(0, 64));
+    std::unordered_map<int, int> gt;
+
+    size_t n_ops = t.range<size_t>(1, 2000);
+    for(size_t k = 0; k < n_ops; k++) {
+        int key = t.range(-200, 200);
+        // small enough that the += below can never overflow
+        int value = t.range(-1000, 1000);
+        switch(t.range(4)) {
+            case 0: {
+                auto ret = map.insert({key, value});
+                auto gt_ret = gt.insert({key, value});
+                if(ret.second != gt_ret.second || ret.first->second != gt_ret.first->second)
+                    return false;
+                break;
+            }
+            case 1:
+                map[key] += value;
+                gt[key] += value;
+                break;
+            case 2:
+                if(map.erase(key) != gt.erase(key))
+                    return false;
+                break;
+            case 3: {
+                auto it = map.find(key);
+                if((it == map.end()) != (gt.find(key) == gt.end()))
+                    return false;
+                break;
+            }
+        }
+        if(map.load_factor() > map.max_load_factor())
+            return false;
+    }
+    return same_contents(gt, map);
+}
+
+TEST(flat_map) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        ASSERT_TRUE(random_operations<std::hash<int>>(t));
+        ASSERT_TRUE(random_operations<clumping_hash>(t));
+    }
+}
+
+TEST(flat_map_erase_iterator) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = FlatUnorderedMap<int, int, clumping_hash>;
+
+        Map map(t.range<size_t>(0, 64));
+        std::unordered_map<int, int> gt;
+        for(size_t k = t.range<size_t>(500); k > 0; k--) {
+            int key = t.get<int>();
+            map.insert({key, key});
+            gt.insert({key, key});
+        }
+
+        // erasing odd keys while iterating sees every key once
+        size_t seen = 0;
+        for(auto it = map.begin(); it != map.end();) {
+            seen++;
+            if(it->first % 2) {
+                gt.erase(it->first);
+                it = map.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+        ASSERT_TRUE(same_contents(gt, map));
+        ASSERT_TRUE(seen >= map.size());
+    }
+}
+
+TEST(flat_map_copy_and_move) {
+    static_assert(std::is_nothrow_move_constructible<FlatUnorderedMap<std::string, double>>::value,
+                  "moving a map cannot throw");
+
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = FlatUnorderedMap<std::string, double>;
+
+        std::vector<std::pair<std::string, double>> pairs(t.range(500ul));
+        t.fill(pairs.begin(), pairs.end());
+
+        Map map(10);
+        for(auto const & pair : pairs)
+            map.insert(pair);
+
+        Map copy(map);
+        ASSERT_EQ(map.size(), copy.size());
+        for(auto const & pair : map)
+            ASSERT_TRUE(copy.find(pair.first) != copy.end());
+
+        // moving allocates nothing, and leaves copy empty but usable
+        Memhook mh;
+        Map moved(std::move(copy));
+        ASSERT_EQ(0ULL, mh.n_allocs());
+        ASSERT_EQ(map.size(), moved.size());
+        ASSERT_TRUE(copy.empty());
+        ASSERT_TRUE(copy.find("") == copy.end());
+        ASSERT_EQ(0ULL, copy.erase(""));
+        Map empty_copy(copy);
+        ASSERT_TRUE(empty_copy.empty());
+        copy[""] = 1;
+        ASSERT_EQ(1ULL, copy.size());
+        ASSERT_EQ(1.0, copy[""]);
+        copy = moved;
+        moved = std::move(copy);
+        ASSERT_EQ(map.size(), moved.size());
+        for(auto const & pair : pairs)
+            ASSERT_EQ(map[pair.first], moved[pair.first]);
+    }
+}
+
+TEST(flat_map_reserve) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = FlatUnorderedMap<double, double>;
+
+        std::vector<std::pair<double, double>> pairs(t.range(1000ul));
+        t.fill(pairs.begin(), pairs.end());
+
+        Map map(0);
+        map.reserve(pairs.size());
+        size_t bucket_count = map.bucket_count();
+
+        // the values live in the table, so filling it allocates nothing
+        Memhook mh;
+        for(auto const & pair : pairs)
+            map.insert(pair);
+        ASSERT_EQ(0ULL, mh.n_allocs());
+        ASSERT_EQ(bucket_count, map.bucket_count());
+    }
+
+    FlatUnorderedMap<int, int> map(10);
+    bool thrown = false;
+    try {
+        map.max_load_factor(1.5f);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
@@ -0,0 +1,58 @@
+#include "executable.h"
+
+// std::hash that counts how often it runs
+struct counting_hash {
+    inline static size_t calls = 0;
+
+    size_t operator()(int key) const {
+        calls++;
+        return std::hash<int>{}(key);
+    }
+};
+
+TEST(hash_codes) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = UnorderedMap<int, int, counting_hash>;
+
+        // few buckets, so chains are long
+        Map map(t.range<size_t>(1, 8));
+        std::vector<int> keys(t.range<size_t>(1, 500));
+        t.fill(keys.begin(), keys.end());
+
+        counting_hash::calls = 0;
+        for(int key : keys)
+            map.insert({key, key});
+        ASSERT_EQ(keys.size(), counting_hash::calls);
+
+        // a lookup hashes its own key, never the ones it walks past
+        for(int key : keys) {
+            counting_hash::calls = 0;
+            ASSERT_TRUE(map.find(key) != map.end());
+            ASSERT_TRUE(counting_hash::calls <= 2);
+        }
+
+        // walking buckets and rehashing reuse the stored codes
+        counting_hash::calls = 0;
+        size_t count = 0;
+        for(size_t b = 0; b < map.bucket_count(); b++) {
+            count += map.bucket_size(b);
+            for(auto it = map.begin(b); it != map.end(b); it++);
+        }
+        map.rehash(map.bucket_count() * 4);
+        ASSERT_EQ(map.size(), count);
+        ASSERT_EQ(0ULL, counting_hash::calls);
+
+        // as does copying
+        Map copy(map);
+        ASSERT_EQ(0ULL, counting_hash::calls);
+        ASSERT_EQ(map.size(), copy.size());
+
+        for(int key : keys) {
+            counting_hash::calls = 0;
+            ASSERT_TRUE(map.erase(key) <= 1);
+            ASSERT_TRUE(counting_hash::calls <= 3);
+        }
+        ASSERT_TRUE(map.empty());
+    }
+}
@@ -0,0 +1,151 @@
+#include "executable.h"
+
+TEST(rehash) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using value_type = std::pair<double, double>;
+        using Map = UnorderedMap<double, double>;
+
+        size_t n = t.range<size_t>(1, 256);
+        size_t m = t.range<size_t>(1, 1024);
+        size_t n_pairs = t.range(1000ul);
+
+        std::vector<value_type> pairs(n_pairs);
+        t.fill(pairs.begin(), pairs.end());
+
+        Map map(n);
+        shadow_map<double, double> shad_map(m);
+        for(auto const & pair : pairs) {
+            map.insert(pair);
+            shad_map.insert(pair);
+        }
+
+        // only the bucket array is replaced, the nodes are relinked
+        {
+            Memhook mh;
+            map.rehash(m);
+            size_t bucket_count = next_greater_prime(m);
+            ASSERT_EQ(bucket_count, map.bucket_count());
+            if(bucket_count != next_greater_prime(n)) {
+                ASSERT_EQ(1ULL, mh.n_allocs());
+                ASSERT_EQ(1ULL, mh.n_frees());
+                ASSERT_EQ(sizeof(void *) * bucket_count, mh.last_alloc().size);
+            }
+            else {
+                ASSERT_EQ(0ULL, mh.n_allocs());
+            }
+        }
+
+        ASSERT_PAIRS_FOUND_IN_CORRECT_BUCKETS(shad_map, map);
+        ASSERT_EQ(shad_map.size(), map.size());
+
+        size_t count = 0;
+        for(auto it = map.begin(); it != map.end(); it++)
+            count++;
+        ASSERT_EQ(map.size(), count);
+
+        for(auto const & pair : pairs) {
+            auto it = map.find(pair.first);
+            ASSERT_TRUE(it != map.end());
+        }
+
+        // never fewer buckets than the size allows
+        map.max_load_factor(2.0f);
+        map.rehash(0);
+        ASSERT_TRUE(map.load_factor() <= 2.0f);
+    }
+}
+
+TEST(max_load_factor) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using value_type = std::pair<std::string, double>;
+        using Map = UnorderedMap<std::string, double>;
+
+        size_t n_pairs = t.range(1000ul);
+        std::vector<value_type> pairs(n_pairs);
+        t.fill(pairs.begin(), pairs.end());
+
+        float ml = t.range(1, 4) / 2.0f;
+        Map map(t.range(100ull));
+        map.max_load_factor(ml);
+        ASSERT_EQ(ml, map.max_load_factor());
+
+        for(auto const & pair : pairs) {
+            map.insert(pair);
+            ASSERT_TRUE(map.load_factor() <= ml);
+        }
+
+        shadow_map<std::string, double> shad_map(map.bucket_count());
+        for(auto const & pair : pairs)
+            shad_map.insert(pair);
+        ASSERT_PAIRS_FOUND_IN_CORRECT_BUCKETS(shad_map, map);
+        ASSERT_EQ(shad_map.size(), map.size());
+    }
+
+    UnorderedMap<int, int> map(10);
+    bool thrown = false;
+    try {
+        map.max_load_factor(0.0f);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
+
+TEST(reserve) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using value_type = std::pair<double, double>;
+        using Map = UnorderedMap<double, double>;
+
+        size_t n_pairs = t.range(1000ul);
+        std::vector<value_type> pairs(n_pairs);
+        t.fill(pairs.begin(), pairs.end());
+
+        Map map(0);
+        map.max_load_factor(1.0f);
+        map.reserve(n_pairs);
+        size_t bucket_count = map.bucket_count();
+        ASSERT_TRUE(bucket_count >= n_pairs);
+
+        // no growth while filling up to the reserved size
+        Memhook mh;
+        for(auto const & pair : pairs)
+            map.operator[](pair.first) = pair.second;
+        ASSERT_EQ(map.size(), mh.n_allocs());
+        ASSERT_EQ(bucket_count, map.bucket_count());
+    }
+}
+
+TEST(reserve_default_load_factor) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using value_type = std::pair<double, double>;
+        using Map = UnorderedMap<double, double>;
+
+        size_t n_pairs = t.range<size_t>(1, 1000);
+        std::vector<value_type> pairs(n_pairs);
+        t.fill(pairs.begin(), pairs.end());
+
+        // with no max load factor, count is the bucket count to reach
+        Map map(t.range<size_t>(1, 256));
+        for(auto const & pair : pairs)
+            map.insert(pair);
+        size_t bucket_count = map.bucket_count();
+        size_t count = t.range<size_t>(0, 4096);
+        map.reserve(count);
+        ASSERT_TRUE(map.bucket_count() >= bucket_count);
+        ASSERT_TRUE(map.bucket_count() >= count);
+
+        // and it never shrinks the table
+        bucket_count = map.bucket_count();
+        map.reserve(0);
+        ASSERT_EQ(bucket_count, map.bucket_count());
+        map.max_load_factor(1.0f);
+        bucket_count = map.bucket_count();
+        map.reserve(1);
+        ASSERT_EQ(bucket_count, map.bucket_count());
+    }
+}
@@ -0,0 +1,112 @@
+#include "executable.h"
+
+#include <memory>
+#include <unordered_map>
+
+// std::hash and std::equal_to that count how often they run
+struct probe_hash {
+    inline static size_t calls = 0;
+
+    size_t operator()(int key) const {
+        calls++;
+        return std::hash<int>{}(key);
+    }
+};
+
+struct probe_equal {
+    inline static size_t calls = 0;
+
+    bool operator()(int lhs, int rhs) const {
+        calls++;
+        return lhs == rhs;
+    }
+};
+
+static void reset_counts() {
+    probe_hash::calls = 0;
+    probe_equal::calls = 0;
+}
+
+TEST(single_probe) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = UnorderedMap<int, int, probe_hash, probe_equal>;
+
+        Map map(t.range<size_t>(1, 64));
+        std::unordered_map<int, int> gt;
+
+        // distinct keys have distinct codes, so a walk compares keys only
+        // on the node it stops at: once on a hit, never on a miss
+        for(size_t k = t.range<size_t>(1, 1000); k > 0; k--) {
+            int key = t.range(-300, 300);
+            bool present = gt.count(key);
+            // small enough that the += below can never overflow
+            int value = t.range(-1000, 1000);
+
+            reset_counts();
+            switch(t.range(5)) {
+                case 0:
+                    map[key] += value;
+                    gt[key] += value;
+                    break;
+                case 1: {
+                    auto ret = map.try_emplace(key, value);
+                    ASSERT_TRUE(ret.second != present);
+                    gt.try_emplace(key, value);
+                    ASSERT_EQ(gt[key], ret.first->second);
+                    break;
+                }
+                case 2: {
+                    auto ret = map.insert_or_assign(key, value);
+                    ASSERT_TRUE(ret.second != present);
+                    ASSERT_EQ(value, ret.first->second);
+                    gt.insert_or_assign(key, value);
+                    break;
+                }
+                case 3:
+                    ASSERT_EQ(gt.erase(key), map.erase(key));
+                    break;
+                case 4:
+                    ASSERT_TRUE((map.find(key) != map.end()) == present);
+                    break;
+            }
+            ASSERT_EQ(1ULL, probe_hash::calls);
+            ASSERT_EQ(present ? 1ULL : 0ULL, probe_equal::calls);
+        }
+
+        ASSERT_EQ(gt.size(), map.size());
+        for(auto const & pair : gt)
+            ASSERT_EQ(pair.second, map.find(pair.first)->second);
+
+        // erasing at an iterator needs neither
+        reset_counts();
+        for(auto it = map.begin(); it != map.end();)
+            it = map.erase(it);
+        ASSERT_EQ(0ULL, probe_hash::calls);
+        ASSERT_EQ(0ULL, probe_equal::calls);
+        ASSERT_TRUE(map.empty());
+    }
+}
+
+TEST(try_emplace_leaves_arguments) {
+    UnorderedMap<std::string, std::unique_ptr<int>> map(10);
+
+    auto value = std::make_unique<int>(1);
+    ASSERT_TRUE(map.try_emplace("one", std::move(value)).second);
+    ASSERT_TRUE(value == nullptr);
+
+    // the key is there, so the pointer is not moved from
+    value = std::make_unique<int>(2);
+    ASSERT_FALSE(map.try_emplace("one", std::move(value)).second);
+    ASSERT_TRUE(value != nullptr);
+    ASSERT_EQ(1, *map["one"]);
+
+    ASSERT_FALSE(map.insert_or_assign("one", std::move(value)).second);
+    ASSERT_TRUE(value == nullptr);
+    ASSERT_EQ(2, *map["one"]);
+
+    std::string key = "two";
+    map[std::move(key)] = std::make_unique<int>(3);
+    ASSERT_EQ(3, *map.find("two")->second);
+    ASSERT_EQ(2ULL, map.size());
+}
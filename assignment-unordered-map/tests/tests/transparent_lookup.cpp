@@ -0,0 +1,62 @@
+#include "executable.h"
+
+#include <string_view>
+
+// Hashes and compares std::string, std::string_view and const char* alike
+struct string_hash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+TEST(transparent_lookup) {
+    Typegen t;
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        using Map = UnorderedMap<std::string, size_t, string_hash, std::equal_to<>>;
+
+        // long enough to live on the heap, so a temporary would allocate
+        std::vector<std::string> keys(t.range<size_t>(1, 200));
+        for(std::string & key : keys)
+            key = t.get<std::string>(32);
+
+        Map map(t.range<size_t>(1, 64));
+        for(size_t k = 0; k < keys.size(); k++)
+            map[keys[k]] = k;
+
+        Memhook mh;
+        for(size_t k = 0; k < keys.size(); k++) {
+            std::string_view view = keys[k];
+            auto it = map.find(view);
+            ASSERT_TRUE(it != map.end());
+            ASSERT_TRUE(keys[k] == it->first);
+            ASSERT_TRUE(map.find(keys[k].c_str()) == it);
+            ASSERT_TRUE(&map[view] == &it->second);
+        }
+        ASSERT_TRUE(map.find(std::string_view("not a key")) == map.end());
+        ASSERT_EQ(0ULL, mh.n_allocs());
+
+        // erase frees the node and the key, and builds nothing
+        size_t size = map.size();
+        size_t frees = mh.n_frees();
+        ASSERT_EQ(1ULL, map.erase(std::string_view(keys[0])));
+        ASSERT_EQ(0ULL, map.erase(std::string_view(keys[0])));
+        ASSERT_EQ(0ULL, mh.n_allocs());
+        ASSERT_TRUE(mh.n_frees() > frees);
+
+        // a missing key is built from the view only to insert it
+        map[std::string_view(keys[0])] = 7;
+        ASSERT_EQ(7ULL, map.find(keys[0])->second);
+        ASSERT_EQ(size, map.size());
+    }
+}
+
+TEST(transparent_lookup_opt_in) {
+    // a non-transparent map converts to Key as before
+    UnorderedMap<std::string, int> map(10);
+    map["one"] = 1;
+    ASSERT_EQ(1, map.find("one")->second);
+    ASSERT_EQ(1ULL, map.erase("one"));
+    ASSERT_TRUE(map.empty());
+}
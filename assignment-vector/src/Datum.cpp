@@ -1,74 +1,251 @@
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <exception>
 #include <fstream>
-#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 #include "Datum.h"
+#if !defined(_WIN32)
+#include "MappedVector.h"
+#endif
 
 std::istream& operator>>(std::istream& in, Datum& datum) {
     std::string hold = "";
     std::getline(in,hold);
-    std::stringstream ss(hold);
-    std::string date = "";
-    std::getline(ss,date,',');
-    std::string neg = "";
-    std::getline(ss,neg,',');
-    std::string pos = "";
-    std::getline(ss,pos,',');
-    std::string tot = "";
-    std::getline(ss,tot,',');
-    std::string percent = "";
-    std::getline(ss,percent,',');
-    datum.week = date;
-    datum.negative = std::stoi(neg);
-    datum.positive = std::stoi(pos);
-    datum.total = std::stoi(tot);
-    datum.positivity = std::stof(percent);
+    parseDatum(hold, datum);
     return in;
 }
 
+namespace {
+    // Cuts the next comma separated field off the front of line
+    std::string_view nextField(std::string_view& line) {
+        size_t comma = line.find(',');
+        std::string_view field = line.substr(0, comma);
+        line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+        return field;
+    }
+
+    // Converts the leading number of field, like stoi/stof would, but
+    // without copying it into a string first
+    template <typename Number>
+    Number toNumber(std::string_view field, std::string_view row) {
+        while (!field.empty() && field.front() == ' ') {
+            field.remove_prefix(1);
+        }
+        Number value{};
+        auto [end, err] = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (err != std::errc()) {
+            throw std::invalid_argument("Malformed row: " + std::string(row));
+        }
+        return value;
+    }
+}
+
+void parseDatum(std::string_view line, Datum& datum) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    std::string_view row = line;
+    std::string_view week = nextField(line);
+    datum.negative = toNumber<unsigned int>(nextField(line), row);
+    datum.positive = toNumber<unsigned int>(nextField(line), row);
+    datum.total = toNumber<unsigned int>(nextField(line), row);
+    // the trailing % stops the conversion
+    datum.positivity = toNumber<float>(nextField(line), row);
+    datum.week.assign(week.data(), week.size());
+}
+
+[[nodiscard]] bool isBadDataEntry(const Datum& datum) noexcept {
+    return isBadDataEntry(datum.negative, datum.positive, datum.total, datum.positivity);
+}
+
 [[nodiscard]] Vector<Datum> badDataEntries(const Vector<Datum>& data) noexcept {
     Vector<Datum> bad_data;
-    for (int i = 0; i < data.size(); i++) {
-        if ((data[i].positivity + 0.1 < data[i].compute_positivity()*100) || (data[i].positivity - 0.1 > data[i].compute_positivity()*100) || (data[i].compute_total() != data[i].total)) {
+    for (size_t i = 0; i < data.size(); i++) {
+        if (isBadDataEntry(data[i])) {
             bad_data.push_back(data[i]);
         }
     }
     return bad_data;
 }
 
+// Stops at the first bad row instead of collecting all of them
 [[nodiscard]] bool goodData(const Vector<Datum>& data) noexcept {
-    if (badDataEntries(data).empty()) {
-        return true;
+    for (size_t i = 0; i < data.size(); i++) {
+        if (isBadDataEntry(data[i])) {
+            return false;
+        }
     }
-    return false;
+    return true;
 }
 
-[[nodiscard]] Vector<Datum> readData(std::istream& file) {
-    std::string hold = "";
-    std::getline(file,hold);
-    Datum placeholder;
+[[nodiscard]] Vector<Datum> readData(std::istream& file, size_t chunk_bytes) {
     Vector<Datum> vec;
-    std::stringstream ss = std::stringstream(hold);
-    while (getline(file,hold)) {
-        std::stringstream ss(hold);
-        std::string date = "";
-        std::getline(ss,date,',');
-        std::string neg = "";
-        std::getline(ss,neg,',');
-        std::string pos = "";
-        std::getline(ss,pos,',');
-        std::string tot = "";
-        std::getline(ss,tot,',');
-        std::string percent = "";
-        std::getline(ss,percent,',');
-        placeholder.week = date;
-        placeholder.negative = std::stoi(neg);
-        placeholder.positive = std::stoi(pos);
-        placeholder.total = std::stoi(tot);
-        placeholder.positivity = std::stof(percent);
-        vec.push_back(placeholder);
+    // a line may straddle two chunks, so the buffer keeps the unfinished
+    // tail of the last chunk at its front and grows if one line is longer
+    // than a whole chunk
+    std::string buffer(chunk_bytes, '\0');
+    size_t kept = 0;
+    bool header = true;
+    while (true) {
+        if (kept == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        file.read(&buffer[kept], buffer.size() - kept);
+        size_t filled = kept + file.gcount();
+        bool done = filled == kept;
+
+        std::string_view text(buffer.data(), filled);
+        size_t line_start = 0;
+        while (line_start < text.size()) {
+            size_t newline = text.find('\n', line_start);
+            if (newline == std::string_view::npos) {
+                if (!done) {
+                    break;
+                }
+                // the last line has no newline
+                newline = text.size();
+            }
+            std::string_view line = text.substr(line_start, newline - line_start);
+            line_start = newline + 1;
+            if (header) {
+                header = false;
+            }
+            else if (!line.empty() && line != "\r") {
+                parseDatum(line, vec.emplace_back());
+            }
+        }
+        if (done) {
+            break;
+        }
+        kept = filled - line_start;
+        std::memmove(&buffer[0], &buffer[line_start], kept);
     }
     return vec;
 }
 
-[[nodiscard]] bool isBadDataEntry(const Datum& datum);
+namespace {
+    // Ranges smaller than this are not worth a thread of their own
+    constexpr size_t min_range_bytes = 1 << 16;
+
+    // Parses every row of text, which holds whole lines only, and notes
+    // the positions of the bad ones
+    void parseRange(std::string_view text, DatumFile& out) {
+        size_t line_start = 0;
+        while (line_start < text.size()) {
+            size_t newline = text.find('\n', line_start);
+            if (newline == std::string_view::npos) {
+                newline = text.size();
+            }
+            std::string_view line = text.substr(line_start, newline - line_start);
+            line_start = newline + 1;
+            if (!line.empty() && line != "\r") {
+                Datum& row = out.rows.emplace_back();
+                parseDatum(line, row);
+                if (isBadDataEntry(row)) {
+                    out.bad.push_back(out.rows.size() - 1);
+                }
+            }
+        }
+    }
+
+    // Moves the first position to just past the next newline
+    size_t lineAfter(std::string_view text, size_t pos) {
+        size_t newline = text.find('\n', pos);
+        return newline == std::string_view::npos ? text.size() : newline + 1;
+    }
+
+    // Runs work(i) for i in [0, count) on count threads and rethrows the
+    // first exception any of them hit. If a thread cannot be started, the
+    // ones already running are joined before that error is rethrown, as
+    // destroying a joinable thread would terminate the program.
+    template <typename Work>
+    void runAll(size_t count, Work work) {
+        Vector<std::exception_ptr> errors(count);
+        Vector<std::thread> pool;
+        pool.reserve(count);
+        try {
+            for (size_t i = 0; i < count; i++) {
+                pool.emplace_back([&work, &errors, i] {
+                    try {
+                        work(i);
+                    }
+                    catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                });
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < pool.size(); i++) {
+                pool[i].join();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; i++) {
+            pool[i].join();
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (errors[i]) {
+                std::rethrow_exception(errors[i]);
+            }
+        }
+    }
+}
+
+[[nodiscard]] DatumFile readDataParallel(std::string_view csv, size_t threads) {
+    csv.remove_prefix(lineAfter(csv, 0));
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    size_t most = csv.size() / min_range_bytes + 1;
+    threads = threads < 1 ? 1 : threads > most ? most : threads;
+
+    // range i is [bounds[i], bounds[i + 1]), each boundary pushed forward
+    // to the start of a line
+    Vector<size_t> bounds(threads + 1);
+    for (size_t i = 1; i < threads; i++) {
+        size_t guess = csv.size() / threads * i;
+        bounds[i] = guess <= bounds[i - 1] ? bounds[i - 1] : lineAfter(csv, guess - 1);
+    }
+    bounds[threads] = csv.size();
+
+    Vector<DatumFile> parts(threads);
+    runAll(threads, [&](size_t i) {
+        parseRange(csv.substr(bounds[i], bounds[i + 1] - bounds[i]), parts[i]);
+    });
+    if (threads == 1) {
+        return std::move(parts[0]);
+    }
+
+    // where each part starts in the joined rows
+    Vector<size_t> offsets(threads + 1);
+    DatumFile joined;
+    for (size_t i = 0; i < threads; i++) {
+        offsets[i + 1] = offsets[i] + parts[i].rows.size();
+        for (size_t k = 0; k < parts[i].bad.size(); k++) {
+            joined.bad.push_back(offsets[i] + parts[i].bad[k]);
+        }
+    }
+
+    // the moves are spread over the same threads
+    joined.rows.resize(offsets[threads]);
+    runAll(threads, [&](size_t i) {
+        Vector<Datum>& rows = parts[i].rows;
+        for (size_t k = 0; k < rows.size(); k++) {
+            joined.rows[offsets[i] + k] = std::move(rows[k]);
+        }
+        rows.clear();
+    });
+    return joined;
+}
+
+#if !defined(_WIN32)
+[[nodiscard]] DatumFile readFileParallel(const std::string& path, size_t threads) {
+    MappedVector<char> file(path);
+    file.advise_sequential();
+    return readDataParallel(std::string_view(file.data(), file.size()), threads);
+}
+#endif
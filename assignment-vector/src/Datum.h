@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "Vector.h"
 
@@ -22,11 +23,46 @@ struct Datum {
     }
 };
 
+// True when total or positivity disagree with the values recomputed from
+// the counts. The arithmetic matches compute_total and compute_positivity,
+// and the tests are combined without branching so loops over columns of
+// rows can be vectorized.
+[[nodiscard]] inline bool isBadDataEntry(unsigned int negative, unsigned int positive, unsigned int total, float positivity) noexcept {
+    unsigned int computed_total = positive + negative;
+    float computed_positivity = positive / float(computed_total) * 100;
+    return (positivity + 0.1 < computed_positivity) | (positivity - 0.1 > computed_positivity) | (computed_total != total);
+}
+
+[[nodiscard]] bool isBadDataEntry(const Datum& datum) noexcept;
+
 std::ostream& operator<<(std::ostream& out, const Datum& datum);
 
 std::istream& operator>>(std::istream& in, Datum& datum);
 
-[[nodiscard]] Vector<Datum> readData(std::istream& file);
+// Fills datum from one CSV row; throws std::invalid_argument when a
+// number is missing or malformed
+void parseDatum(std::string_view line, Datum& datum);
+
+// Reads the file chunk_bytes at a time and parses the rows in place,
+// skipping the header line. Only a long week string allocates.
+[[nodiscard]] Vector<Datum> readData(std::istream& file, size_t chunk_bytes = 1 << 16);
+
+// The rows of a CSV file together with the positions of the bad ones
+struct DatumFile {
+    Vector<Datum> rows;
+    Vector<size_t> bad;
+};
+
+// Splits csv, header included, into newline aligned ranges, parses and
+// validates them on up to threads threads (0 picks one per core) and
+// joins the results in file order
+[[nodiscard]] DatumFile readDataParallel(std::string_view csv, size_t threads = 0);
+
+#if !defined(_WIN32)
+// readDataParallel over a memory mapped file, without reading it first.
+// Only on POSIX systems, as it maps the file with mmap.
+[[nodiscard]] DatumFile readFileParallel(const std::string& path, size_t threads = 0);
+#endif
 
 [[nodiscard]] Vector<Datum> badDataEntries(const Vector<Datum>& data) noexcept;
 
@@ -0,0 +1,89 @@
+#include "DatumTable.h"
+
+namespace {
+    // Rows checked between early exits in goodData; big enough for the
+    // inner loop to vectorize, small enough to stop soon after a bad row
+    constexpr size_t block_rows = 256;
+
+    // Writes isBadDataEntry for rows [first, last) to bad. No branches in
+    // the loop body, so optimized builds turn it into SIMD compares.
+    void markBad(const DatumTable& table, size_t first, size_t last, unsigned char* bad) noexcept {
+        const unsigned int* negative = table.negative.data();
+        const unsigned int* positive = table.positive.data();
+        const unsigned int* total = table.total.data();
+        const float* positivity = table.positivity.data();
+        for (size_t i = first; i < last; i++) {
+            bad[i - first] = isBadDataEntry(negative[i], positive[i], total[i], positivity[i]);
+        }
+    }
+}
+
+DatumTable::DatumTable(const Vector<Datum>& rows) {
+    reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        push_back(rows[i]);
+    }
+}
+
+void DatumTable::reserve(size_t count) {
+    week.reserve(count);
+    negative.reserve(count);
+    positive.reserve(count);
+    total.reserve(count);
+    positivity.reserve(count);
+}
+
+void DatumTable::push_back(const Datum& datum) {
+    week.push_back(datum.week);
+    negative.push_back(datum.negative);
+    positive.push_back(datum.positive);
+    total.push_back(datum.total);
+    positivity.push_back(datum.positivity);
+}
+
+[[nodiscard]] Datum DatumTable::row(size_t i) const {
+    Datum datum;
+    datum.week = week[i];
+    datum.negative = negative[i];
+    datum.positive = positive[i];
+    datum.total = total[i];
+    datum.positivity = positivity[i];
+    return datum;
+}
+
+[[nodiscard]] Vector<unsigned char> badDataMask(const DatumTable& table) {
+    Vector<unsigned char> mask(table.size());
+    markBad(table, 0, table.size(), mask.data());
+    return mask;
+}
+
+[[nodiscard]] Vector<size_t> badDataIndices(const DatumTable& table) {
+    Vector<size_t> indices;
+    unsigned char bad[block_rows];
+    for (size_t first = 0; first < table.size(); first += block_rows) {
+        size_t last = first + block_rows < table.size() ? first + block_rows : table.size();
+        markBad(table, first, last, bad);
+        for (size_t i = first; i < last; i++) {
+            if (bad[i - first]) {
+                indices.push_back(i);
+            }
+        }
+    }
+    return indices;
+}
+
+[[nodiscard]] bool goodData(const DatumTable& table) noexcept {
+    unsigned char bad[block_rows];
+    for (size_t first = 0; first < table.size(); first += block_rows) {
+        size_t last = first + block_rows < table.size() ? first + block_rows : table.size();
+        markBad(table, first, last, bad);
+        unsigned char any = 0;
+        for (size_t i = 0; i < last - first; i++) {
+            any |= bad[i];
+        }
+        if (any) {
+            return false;
+        }
+    }
+    return true;
+}
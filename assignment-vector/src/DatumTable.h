@@ -0,0 +1,48 @@
+#ifndef DATUM_TABLE_H
+#define DATUM_TABLE_H
+
+#include <cstddef> // size_t
+#include <string> // std::string
+
+#include "Datum.h"
+#include "Vector.h"
+
+// The same rows as a Vector<Datum>, stored one column per field. The
+// validation pass only reads the four numeric columns, each contiguous,
+// so it streams through a fraction of the memory and the compiler can
+// vectorize it; the week strings are never touched.
+struct DatumTable {
+    Vector<std::string> week;
+    Vector<unsigned int> negative;
+    Vector<unsigned int> positive;
+    Vector<unsigned int> total;
+    Vector<float> positivity;
+
+    DatumTable() = default;
+    explicit DatumTable(const Vector<Datum>& rows);
+
+    [[nodiscard]] size_t size() const noexcept {
+        return total.size();
+    }
+    [[nodiscard]] bool empty() const noexcept {
+        return total.empty();
+    }
+
+    void reserve(size_t count);
+    void push_back(const Datum& datum);
+
+    // Gathers row i back into a Datum
+    [[nodiscard]] Datum row(size_t i) const;
+};
+
+// One byte per row, 1 where isBadDataEntry holds and 0 otherwise
+[[nodiscard]] Vector<unsigned char> badDataMask(const DatumTable& table);
+
+// Positions of the bad rows in increasing order, without copying them
+[[nodiscard]] Vector<size_t> badDataIndices(const DatumTable& table);
+
+// Checks a block of rows at a time and stops at the first block with a
+// bad row
+[[nodiscard]] bool goodData(const DatumTable& table) noexcept;
+
+#endif
@@ -0,0 +1,443 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm> // std::rotate, std::fill
+#include <cstddef> // size_t
+#include <cstring> // std::memcpy
+#include <iterator> // std::iterator_traits, std::distance, std::make_move_iterator
+#include <memory> // std::allocator, std::allocator_traits
+#include <stdexcept> // std::out_of_range
+#include <type_traits> // std::enable_if_t
+
+#include "Vector.h"
+
+// A Vector that keeps its first N elements inside the object itself and
+// only allocates once it holds more than N. It has the same interface and
+// iterator as Vector, so small, short lived vectors cost no allocation.
+//
+// Moving a SmallVector whose elements are inline moves them one by one;
+// once spilled to the heap the buffer is stolen as with Vector, unless
+// move assignment would leave it with an allocator that cannot free it. A spilled
+// SmallVector returns to its inline storage when shrink_to_fit is called
+// with at most N elements left.
+template <class T, size_t N, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
+class SmallVector {
+public:
+    using iterator = typename Vector<T, Allocator, GrowthPolicy>::iterator;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    static constexpr size_t inline_capacity = N;
+private:
+    static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    T* array;
+    size_t _capacity, _size;
+    Allocator _alloc;
+    alignas(T) unsigned char _inline[N * sizeof(T)];
+
+    static constexpr bool _relocatable = is_trivially_relocatable<T>::value;
+
+    template <class It>
+    using _require_iterator = std::enable_if_t<std::is_base_of<
+        std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>;
+
+    template <class It>
+    static constexpr bool _is_forward = std::is_base_of<
+        std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+    T* _inline_data() noexcept {
+        return reinterpret_cast<T*>(_inline);
+    }
+    bool _is_inline() const noexcept {
+        return array == reinterpret_cast<const T*>(_inline);
+    }
+
+    void _destroy(T* first, T* last) noexcept {
+        for (; first != last; ++first) {
+            alloc_traits::destroy(_alloc, first);
+        }
+    }
+    // Hands a heap buffer back; the inline storage is never freed
+    void _free_buffer() noexcept {
+        if (!_is_inline()) {
+            alloc_traits::deallocate(_alloc, array, _capacity);
+        }
+        array = _inline_data();
+        _capacity = N;
+    }
+
+    // Moves the live elements into dest, which has room for them
+    void _move_into(T* dest) {
+        if constexpr (_relocatable) {
+            if (_size != 0) {
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(array), _size * sizeof(T));
+            }
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i < _size; i++) {
+                    alloc_traits::construct(_alloc, dest + i, std::move(array[i]));
+                }
+            }
+            catch (...) {
+                _destroy(dest, dest + i);
+                throw;
+            }
+            _destroy(array, array + _size);
+        }
+    }
+
+    // Moves the elements into a buffer of new_capacity slots, which is the
+    // inline storage when they fit there and the buffer is on the heap
+    void _reallocate(size_t new_capacity) {
+        if (new_capacity <= N) {
+            if (_is_inline()) {
+                return;
+            }
+            T* heap = array;
+            size_t heap_capacity = _capacity;
+            _move_into(_inline_data());
+            alloc_traits::deallocate(_alloc, heap, heap_capacity);
+            array = _inline_data();
+            _capacity = N;
+            return;
+        }
+        T* hold = alloc_traits::allocate(_alloc, new_capacity);
+        try {
+            _move_into(hold);
+        }
+        catch (...) {
+            alloc_traits::deallocate(_alloc, hold, new_capacity);
+            throw;
+        }
+        _free_buffer();
+        array = hold;
+        _capacity = new_capacity;
+    }
+
+    // Ensures room for extra more elements with at most one reallocation
+    void _make_room(size_t extra) {
+        if (_size + extra > _capacity) {
+            _reallocate(GrowthPolicy::next_capacity(_capacity, _size + extra));
+        }
+    }
+
+    size_t _check_position(iterator pos, bool allow_end) const {
+        typename iterator::difference_type loc = pos - iterator(array);
+        if (loc < 0 || static_cast<size_t>(loc) > _size || (!allow_end && static_cast<size_t>(loc) == _size)) {
+            throw std::out_of_range("");
+        }
+        return loc;
+    }
+
+    // Appended elements [old_size, _size) are rotated to loc
+    iterator _rotate_into_place(size_t loc, size_t old_size) {
+        std::rotate(array + loc, array + old_size, array + _size);
+        return iterator(array + loc);
+    }
+
+    // Steals the heap buffer, or moves the inline elements one by one
+    void _take(SmallVector& other) {
+        if (other._is_inline()) {
+            for (; _size < other._size; _size++) {
+                alloc_traits::construct(_alloc, array + _size, std::move(other.array[_size]));
+            }
+            other.clear();
+        }
+        else {
+            array = other.array;
+            _capacity = other._capacity;
+            _size = other._size;
+            other.array = other._inline_data();
+            other._capacity = N;
+            other._size = 0;
+        }
+    }
+
+public:
+    SmallVector() noexcept(noexcept(Allocator())) : array(_inline_data()), _capacity(N), _size(0), _alloc() {}
+
+    explicit SmallVector(const Allocator& alloc) noexcept : array(_inline_data()), _capacity(N), _size(0), _alloc(alloc) {}
+
+    SmallVector(size_t count, const T& value, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+        insert(end(), count, value);
+    }
+
+    explicit SmallVector(size_t count, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+        resize(count);
+    }
+
+    template <class InputIt, class = _require_iterator<InputIt>>
+    SmallVector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : SmallVector(alloc) {
+        insert(end(), first, last);
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector(alloc_traits::select_on_container_copy_construction(other._alloc)) {
+        insert(end(), other.array, other.array + other._size);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : array(_inline_data()), _capacity(N), _size(0), _alloc(std::move(other._alloc)) {
+        _take(other);
+    }
+
+    ~SmallVector() {
+        clear();
+        _free_buffer();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (alloc_traits::propagate_on_container_copy_assignment::value && _alloc != other._alloc) {
+            clear();
+            _free_buffer();
+            _alloc = other._alloc;
+        }
+        assign(other.array, other.array + other._size);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (!alloc_traits::propagate_on_container_move_assignment::value && _alloc != other._alloc) {
+            // _alloc cannot free other's buffer, so the elements are moved
+            // into this one instead
+            assign(std::make_move_iterator(other.array), std::make_move_iterator(other.array + other._size));
+            other.clear();
+            return *this;
+        }
+        clear();
+        _free_buffer();
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            _alloc = std::move(other._alloc);
+        }
+        _take(other);
+        return *this;
+    }
+
+    void assign(size_t count, const T& value) {
+        if (count > _capacity) {
+            *this = SmallVector(count, value, _alloc);
+            return;
+        }
+        size_t overlap = count < _size ? count : _size;
+        std::fill(array, array + overlap, value);
+        for (; _size < count; _size++) {
+            alloc_traits::construct(_alloc, array + _size, value);
+        }
+        _destroy(array + count, array + _size);
+        _size = count;
+    }
+    template <class InputIt, class = _require_iterator<InputIt>>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return _alloc;
+    }
+
+    iterator begin() noexcept {
+        return iterator(array);
+    }
+    iterator end() noexcept {
+        return iterator(array + _size);
+    }
+
+    // Direct access to the contiguous elements
+    T* data() noexcept {
+        return array;
+    }
+    const T* data() const noexcept {
+        return array;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    // True while the elements live inside the object
+    bool is_small() const noexcept {
+        return _is_inline();
+    }
+
+    void reserve(size_t new_cap) {
+        if (new_cap > _capacity) {
+            _reallocate(new_cap);
+        }
+    }
+
+    // Moves back to the inline storage when the elements fit there
+    void shrink_to_fit() {
+        if (!_is_inline() && _size < _capacity) {
+            _reallocate(_size);
+        }
+    }
+
+    void resize(size_t count) {
+        if (count <= _size) {
+            _destroy(array + count, array + _size);
+            _size = count;
+            return;
+        }
+        reserve(count);
+        for (; _size < count; _size++) {
+            alloc_traits::construct(_alloc, array + _size);
+        }
+    }
+    void resize(size_t count, const T& value) {
+        if (count <= _size) {
+            _destroy(array + count, array + _size);
+            _size = count;
+            return;
+        }
+        insert(end(), count - _size, value);
+    }
+
+    T& at(size_t pos) {
+        if (pos >= _size) {
+            throw std::out_of_range("Out of bounds access");
+        }
+        return array[pos];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= _size) {
+            throw std::out_of_range("Out of bounds access");
+        }
+        return array[pos];
+    }
+    T& operator[](size_t pos) {
+        return array[pos];
+    }
+    const T& operator[](size_t pos) const {
+        return array[pos];
+    }
+
+    T& front() {
+        return array[0];
+    }
+    const T& front() const {
+        return array[0];
+    }
+    T& back() {
+        return array[_size - 1];
+    }
+    const T& back() const {
+        return array[_size - 1];
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity) {
+            // args may refer to an element that is about to move
+            T hold(std::forward<Args>(args)...);
+            _make_room(1);
+            alloc_traits::construct(_alloc, array + _size, std::move(hold));
+        }
+        else {
+            alloc_traits::construct(_alloc, array + _size, std::forward<Args>(args)...);
+        }
+        _size += 1;
+        return array[_size - 1];
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        _size -= 1;
+        alloc_traits::destroy(_alloc, array + _size);
+    }
+
+    template <class... Args>
+    iterator emplace(iterator pos, Args&&... args) {
+        size_t loc = _check_position(pos, true);
+        size_t old_size = _size;
+        emplace_back(std::forward<Args>(args)...);
+        return _rotate_into_place(loc, old_size);
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+    iterator insert(iterator pos, size_t count, const T& value) {
+        size_t loc = _check_position(pos, true);
+        if (count != 0 && &value >= array && &value < array + _size) {
+            T hold(value);
+            return insert(pos, count, hold);
+        }
+        size_t old_size = _size;
+        _make_room(count);
+        for (size_t i = 0; i < count; i++) {
+            alloc_traits::construct(_alloc, array + _size, value);
+            _size += 1;
+        }
+        return _rotate_into_place(loc, old_size);
+    }
+    template <class InputIt, class = _require_iterator<InputIt>>
+    iterator insert(iterator pos, InputIt first, InputIt last) {
+        size_t loc = _check_position(pos, true);
+        size_t old_size = _size;
+        if constexpr (_is_forward<InputIt>) {
+            _make_room(std::distance(first, last));
+            for (; first != last; ++first) {
+                alloc_traits::construct(_alloc, array + _size, *first);
+                _size += 1;
+            }
+        }
+        else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        return _rotate_into_place(loc, old_size);
+    }
+
+    iterator erase(iterator pos) {
+        size_t loc = _check_position(pos, false);
+        std::move(array + loc + 1, array + _size, array + loc);
+        pop_back();
+        return iterator(array + loc);
+    }
+    iterator erase(iterator first, iterator last) {
+        size_t start = first - begin();
+        size_t end = last - begin();
+        if (start == end) {
+            return first;
+        }
+        std::move(array + end, array + _size, array + start);
+        _destroy(array + _size - (end - start), array + _size);
+        _size -= end - start;
+        return iterator(array + start);
+    }
+
+    void clear() noexcept {
+        _destroy(array, array + _size);
+        _size = 0;
+    }
+};
+
+#endif
@@ -3,102 +3,449 @@
 
 #include <algorithm> // std::random_access_iterator_tag
 #include <cstddef> // size_t
+#include <cstring> // std::memmove
+#include <iterator> // std::iterator_traits, std::distance
+#include <memory> // std::allocator, std::allocator_traits
 #include <stdexcept> // std::range_error
-
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::swap
+
+// A type is trivially relocatable if moving an object to a new address and
+// forgetting the old one can be done by copying its bytes. Vector then
+// grows, inserts and erases with memcpy/memmove instead of per-element
+// moves, and skips the allocator's construct/destroy for relocated objects.
+// Every trivially copyable type qualifies. Other types that do not point
+// into themselves (e.g. a Box or unique_ptr style owner) can opt in:
+//
+//     template <> struct is_trivially_relocatable<MyType> : std::true_type {};
 template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Growth policies decide the capacity push_back and insert reallocate to
+// once the buffer is full. next_capacity must return at least required.
+
+// 1, 2, 4, 8, ...
+struct DoublingGrowth {
+    static size_t next_capacity(size_t capacity, size_t required) noexcept {
+        size_t next = capacity == 0 ? 1 : capacity * 2;
+        return next < required ? required : next;
+    }
+};
+
+// 1, 2, 3, 4, 6, 9, 13, ... trades more reallocations for less slack
+struct HalfGrowth {
+    static size_t next_capacity(size_t capacity, size_t required) noexcept {
+        size_t next = capacity + capacity / 2;
+        if (next == capacity) {
+            next += 1;
+        }
+        return next < required ? required : next;
+    }
+};
+
+// Grows by a constant number of elements (rounded up to cover required)
+template <size_t Chunk>
+struct ChunkGrowth {
+    static_assert(Chunk > 0, "ChunkGrowth needs a positive chunk size");
+
+    static size_t next_capacity(size_t capacity, size_t required) noexcept {
+        size_t next = capacity + Chunk;
+        if (next < required) {
+            next = required + (Chunk - required % Chunk) % Chunk;
+        }
+        return next;
+    }
+};
+
+template <class T, class Allocator = std::allocator<T>, class GrowthPolicy = DoublingGrowth>
 class Vector {
 public:
     class iterator;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
 private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
     T* array;
     size_t _capacity, _size;
+    Allocator _alloc;
 
-    // You may want to write a function that grows the vector
-    void grow() {
-        if (_capacity == 0) {
-            _capacity += 1;
+    // The buffer is raw storage: only [0, _size) holds live objects, the
+    // rest of the capacity is never constructed
+    T* _allocate(size_t count) {
+        return alloc_traits::allocate(_alloc, count);
+    }
+    void _deallocate(T* ptr, size_t count) noexcept {
+        if (ptr != nullptr) {
+            alloc_traits::deallocate(_alloc, ptr, count);
         }
-        else {
-            _capacity *= 2;
+    }
+    void _destroy(T* first, T* last) noexcept {
+        for (; first != last; ++first) {
+            alloc_traits::destroy(_alloc, first);
+        }
+    }
+    static constexpr bool _relocatable = is_trivially_relocatable<T>::value;
+
+    // Keeps the iterator range overloads from hijacking calls like
+    // Vector<int>(5, 1), where both arguments are plain integers
+    template <class It>
+    using _require_iterator = std::enable_if_t<std::is_base_of<
+        std::input_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value>;
+
+    template <class It>
+    static constexpr bool _is_forward = std::is_base_of<
+        std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+    // Byte-wise relocation for trivially relocatable types. The ranges may
+    // overlap; afterwards src is raw memory that must not be destroyed.
+    static void _relocate(T* dest, const T* src, size_t count) noexcept {
+        if (count != 0) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+        }
+    }
+
+    // Destroys every element and hands the buffer back to the allocator
+    void _release() noexcept {
+        _destroy(array, array + _size);
+        _deallocate(array, _capacity);
+        array = nullptr;
+    }
+
+    // Moves the live elements into hold, a fresh buffer of new_capacity
+    // slots whose [loc, loc + gap) is already constructed, and adopts it.
+    // Elements before loc keep their index, the rest shift up by gap. If a
+    // move throws, everything built in hold is destroyed and hold is freed.
+    void _adopt(T* hold, size_t new_capacity, size_t loc, size_t gap) {
+        if constexpr (_relocatable) {
+            _relocate(hold, array, loc);
+            _relocate(hold + loc + gap, array + loc, _size - loc);
         }
-        T* hold = new T[_capacity];
-        for (int i = 0; i < _size; i++) {
-            hold[i] = std::move(array[i]);
+        else {
+            size_t i = 0;
+            try {
+                for (; i < _size; i++) {
+                    alloc_traits::construct(_alloc, hold + i + (i >= loc ? gap : 0), std::move(array[i]));
+                }
+            }
+            catch (...) {
+                for (size_t j = 0; j < i; j++) {
+                    alloc_traits::destroy(_alloc, hold + j + (j >= loc ? gap : 0));
+                }
+                _destroy(hold + loc, hold + loc + gap);
+                _deallocate(hold, new_capacity);
+                throw;
+            }
+            _destroy(array, array + _size);
         }
-        delete[] array;
+        _deallocate(array, _capacity);
         array = hold;
+        _capacity = new_capacity;
+        _size += gap;
     }
 
-public:
-    Vector() noexcept {
-        _capacity = 0;
-        _size = 0;
-        array = nullptr;
+    // Moves the live elements into a buffer of exactly new_capacity slots
+    void _reallocate(size_t new_capacity) {
+        T* hold = new_capacity == 0 ? nullptr : _allocate(new_capacity);
+        _adopt(hold, new_capacity, _size, 0);
+    }
+
+    // Reallocates to make room for one more element and constructs it at
+    // loc in the new buffer before the old elements are moved over, so args
+    // may safely refer to elements of this vector
+    template <class... Args>
+    void _grow_insert(size_t loc, Args&&... args) {
+        size_t new_capacity = GrowthPolicy::next_capacity(_capacity, _size + 1);
+        T* hold = _allocate(new_capacity);
+        try {
+            alloc_traits::construct(_alloc, hold + loc, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            _deallocate(hold, new_capacity);
+            throw;
+        }
+        _adopt(hold, new_capacity, loc, 1);
+    }
+
+    // Yields the same value over and over, so insert(pos, count, value)
+    // can share the range insert
+    struct _repeat {
+        const T* value;
+        const T& operator*() const noexcept {
+            return *value;
+        }
+        _repeat& operator++() noexcept {
+            return *this;
+        }
+    };
+
+    // Inserts count elements copied from first, first + 1, ... at loc.
+    // Reallocates at most once and shifts the tail exactly once. Source is
+    // only dereferenced and incremented, in order.
+    template <class Source>
+    void _insert_n(size_t loc, size_t count, Source first) {
+        if (count == 0) {
+            return;
+        }
+        if (_size + count > _capacity) {
+            // build the new elements first, they may be copies of old ones
+            size_t new_capacity = GrowthPolicy::next_capacity(_capacity, _size + count);
+            T* hold = _allocate(new_capacity);
+            size_t i = 0;
+            try {
+                for (; i < count; i++, ++first) {
+                    alloc_traits::construct(_alloc, hold + loc + i, *first);
+                }
+            }
+            catch (...) {
+                _destroy(hold + loc, hold + loc + i);
+                _deallocate(hold, new_capacity);
+                throw;
+            }
+            _adopt(hold, new_capacity, loc, count);
+            return;
+        }
+
+        size_t tail = _size - loc;
+        if constexpr (_relocatable) {
+            _relocate(array + loc + count, array + loc, tail);
+            size_t i = 0;
+            try {
+                for (; i < count; i++, ++first) {
+                    alloc_traits::construct(_alloc, array + loc + i, *first);
+                }
+            }
+            catch (...) {
+                _destroy(array + loc, array + loc + i);
+                _relocate(array + loc, array + loc + count, tail);
+                throw;
+            }
+            _size += count;
+        }
+        else if (count < tail) {
+            // the last count elements move into raw memory, the rest of the
+            // tail shifts within the live range, then the gap is assigned
+            for (size_t i = 0; i < count; i++) {
+                alloc_traits::construct(_alloc, array + _size + i, std::move(array[_size - count + i]));
+            }
+            std::move_backward(array + loc, array + _size - count, array + _size);
+            _size += count;
+            for (size_t i = 0; i < count; i++, ++first) {
+                array[loc + i] = *first;
+            }
+        }
+        else {
+            // the gap reaches past the old end: the part of it in raw memory
+            // is constructed, the old tail moves past it and the rest is
+            // assigned over the moved-from tail
+            Source mid = first;
+            for (size_t i = 0; i < tail; i++) {
+                ++mid;
+            }
+            size_t built = 0;
+            try {
+                for (; built < count - tail; built++, ++mid) {
+                    alloc_traits::construct(_alloc, array + _size + built, *mid);
+                }
+                for (size_t i = 0; i < tail; i++, built++) {
+                    alloc_traits::construct(_alloc, array + loc + count + i, std::move(array[loc + i]));
+                }
+            }
+            catch (...) {
+                _destroy(array + _size, array + _size + built);
+                throw;
+            }
+            _size += count;
+            for (size_t i = 0; i < tail; i++, ++first) {
+                array[loc + i] = *first;
+            }
+        }
+    }
+
+    // Opens a one element gap at loc < _size, which needs spare capacity.
+    // The slot past the old end is raw memory, so the last element is
+    // move-constructed into it and the rest are move-assigned. The gap is
+    // left holding a live, moved-from object, except for trivially
+    // relocatable types where the tail is memmoved and the gap is raw.
+    void _open_gap(size_t loc) {
+        if constexpr (_relocatable) {
+            _relocate(array + loc + 1, array + loc, _size - loc);
+        }
+        else {
+            alloc_traits::construct(_alloc, array + _size, std::move(array[_size - 1]));
+            for (size_t i = _size - 1; i > loc; i--) {
+                array[i] = std::move(array[i - 1]);
+            }
+        }
     }
 
-    Vector(size_t count, const T& value) {
-        _capacity = count;
+    // Copy constructs [first, first + count) into the front of a freshly
+    // allocated, empty buffer
+    void _construct_copies(const T* first, size_t count) {
+        size_t i = 0;
+        try {
+            for (; i < count; i++) {
+                alloc_traits::construct(_alloc, array + i, first[i]);
+            }
+        }
+        catch (...) {
+            _destroy(array, array + i);
+            _deallocate(array, _capacity);
+            array = nullptr;
+            throw;
+        }
         _size = count;
-        array = new T[count];
-        for (int i = 0; i < count; i++) {
-            array[i] = value;
+    }
+
+public:
+    Vector() noexcept(noexcept(Allocator())) : array(nullptr), _capacity(0), _size(0), _alloc() {}
+
+    explicit Vector(const Allocator& alloc) noexcept : array(nullptr), _capacity(0), _size(0), _alloc(alloc) {}
+
+    Vector(size_t count, const T& value, const Allocator& alloc = Allocator()) : array(nullptr), _capacity(count), _size(0), _alloc(alloc) {
+        array = _allocate(count);
+        size_t i = 0;
+        try {
+            for (; i < count; i++) {
+                alloc_traits::construct(_alloc, array + i, value);
+            }
+        }
+        catch (...) {
+            _destroy(array, array + i);
+            _deallocate(array, _capacity);
+            throw;
         }
+        _size = count;
     }
 
-    explicit Vector(size_t count) {
-        _capacity = count;
+    explicit Vector(size_t count, const Allocator& alloc = Allocator()) : array(nullptr), _capacity(count), _size(0), _alloc(alloc) {
+        array = _allocate(count);
+        size_t i = 0;
+        try {
+            for (; i < count; i++) {
+                // value-initialized, so Vector<int>(n) is all zeros
+                alloc_traits::construct(_alloc, array + i);
+            }
+        }
+        catch (...) {
+            _destroy(array, array + i);
+            _deallocate(array, _capacity);
+            throw;
+        }
         _size = count;
-        array = new T[count]();
     }
 
-    Vector(const Vector& other) {
-        _size = other._size;
-        _capacity = other._capacity;
-        array = new T[_capacity];
-        for (int i = 0; i < _size; i++) {
-            array[i] = other.array[i];
+    // Sizes the buffer once up front when the range can be measured
+    template <class InputIt, class = _require_iterator<InputIt>>
+    Vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : array(nullptr), _capacity(0), _size(0), _alloc(alloc) {
+        try {
+            insert(end(), first, last);
+        }
+        catch (...) {
+            _release();
+            throw;
         }
     }
 
-    Vector(Vector&& other) noexcept : array(other.array), _capacity(other._capacity), _size(other._size){
+    Vector(const Vector& other)
+        : array(nullptr), _capacity(other._capacity), _size(0),
+          _alloc(alloc_traits::select_on_container_copy_construction(other._alloc)) {
+        array = _allocate(_capacity);
+        _construct_copies(other.array, other._size);
+    }
+
+    Vector(Vector&& other) noexcept : array(other.array), _capacity(other._capacity), _size(other._size), _alloc(std::move(other._alloc)) {
         other._size = 0;
         other._capacity = 0;
         other.array = nullptr;
     }
 
     ~Vector() {
-        delete[] array;
+        _release();
     }
 
-    // copy and move operators need to deallocate memory before copying over it
+    // The copy is built in a buffer of its own before the old one is
+    // released, so if allocating or copying throws this vector is left as
+    // it was
     Vector& operator=(const Vector& other) {
         if (this == &other) {
             return *this;
         }
-        _size = other._size;
-        _capacity = other._capacity;
-        delete[] array;
-        array = new T[_capacity];
-        for (int i = 0; i < _size; i++) {
-            array[i] = other.array[i];
-        }
+        Vector copy(alloc_traits::propagate_on_container_copy_assignment::value ? other._alloc : _alloc);
+        copy._capacity = other._capacity;
+        copy.array = copy._allocate(copy._capacity);
+        copy._construct_copies(other.array, other._size);
+        // copy takes the old buffer, and the allocator that can free it
+        std::swap(array, copy.array);
+        std::swap(_size, copy._size);
+        std::swap(_capacity, copy._capacity);
+        std::swap(_alloc, copy._alloc);
         return *this;
     }
 
+    // move operator needs to deallocate memory before taking over the buffer
     Vector& operator=(Vector&& other) noexcept {
         if (this == &other) {
             return *this;
         }
-        delete[] array;
-        std::swap(_size, other._size);
-        std::swap(_capacity, other._capacity);
-        std::swap(array, other.array);
+        _release();
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            _alloc = std::move(other._alloc);
+        }
+        array = other.array;
+        _size = other._size;
+        _capacity = other._capacity;
         other._size = 0;
         other._capacity = 0;
         other.array = nullptr;
         return *this;
     }
 
+    // Replaces the contents, reusing the buffer when it is big enough
+    void assign(size_t count, const T& value) {
+        if (count > _capacity) {
+            *this = Vector(count, value, _alloc);
+            return;
+        }
+        size_t overlap = count < _size ? count : _size;
+        std::fill(array, array + overlap, value);
+        for (; _size < count; _size++) {
+            alloc_traits::construct(_alloc, array + _size, value);
+        }
+        _destroy(array + count, array + _size);
+        _size = count;
+    }
+    template <class InputIt, class = _require_iterator<InputIt>>
+    void assign(InputIt first, InputIt last) {
+        if constexpr (_is_forward<InputIt>) {
+            size_t count = std::distance(first, last);
+            if (count > _capacity) {
+                *this = Vector(first, last, _alloc);
+                return;
+            }
+            size_t i = 0;
+            for (; i < _size && first != last; i++, ++first) {
+                array[i] = *first;
+            }
+            _destroy(array + i, array + _size);
+            _size = i;
+            for (; first != last; ++first) {
+                alloc_traits::construct(_alloc, array + _size, *first);
+                _size += 1;
+            }
+        }
+        else {
+            clear();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return _alloc;
+    }
+
     iterator begin() noexcept {
         return &array[0];
     }
@@ -106,6 +453,14 @@ public:
         return &array[_size];
     }
 
+    // Direct access to the contiguous elements
+    T* data() noexcept {
+        return array;
+    }
+    const T* data() const noexcept {
+        return array;
+    }
+
     [[nodiscard]] bool empty() const noexcept {
         if (_size == 0) {
             return true;
@@ -121,6 +476,49 @@ public:
         return _capacity;
     }
 
+    // Reallocates only if new_cap is larger than the current capacity
+    void reserve(size_t new_cap) {
+        if (new_cap > _capacity) {
+            _reallocate(new_cap);
+        }
+    }
+
+    // Drops any unused capacity; an empty vector releases its buffer
+    void shrink_to_fit() {
+        if (_size < _capacity) {
+            _reallocate(_size);
+        }
+    }
+
+    // Value-initializes new elements, or destroys the ones past count
+    void resize(size_t count) {
+        if (count <= _size) {
+            _destroy(array + count, array + _size);
+            _size = count;
+            return;
+        }
+        reserve(count);
+        for (; _size < count; _size++) {
+            alloc_traits::construct(_alloc, array + _size);
+        }
+    }
+    void resize(size_t count, const T& value) {
+        if (count <= _size) {
+            _destroy(array + count, array + _size);
+            _size = count;
+            return;
+        }
+        if (count > _capacity && &value >= array && &value < array + _size) {
+            T hold(value);
+            resize(count, hold);
+            return;
+        }
+        reserve(count);
+        for (; _size < count; _size++) {
+            alloc_traits::construct(_alloc, array + _size, value);
+        }
+    }
+
     T& at(size_t pos) {
         if (pos >= _size) {
             throw std::out_of_range("Out of bounds access");
@@ -154,91 +552,143 @@ public:
         return array[_size - 1];
     }
 
-    void push_back(const T& value) {
+    // Constructs the element in place from args
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
         if (_size == _capacity) {
-            grow();
+            _grow_insert(_size, std::forward<Args>(args)...);
+        }
+        else {
+            alloc_traits::construct(_alloc, array + _size, std::forward<Args>(args)...);
+            _size += 1;
         }
-        array[_size] = value;
-        _size += 1; 
+        return array[_size - 1];
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
     }
 
     void push_back(T&& value) {
-        if (_size == _capacity) {
-            grow();
-        }
-        array[_size] = std::move(value);
-        _size += 1;
+        emplace_back(std::move(value));
     }
 
     void pop_back() {
         _size -= 1;
+        alloc_traits::destroy(_alloc, array + _size);
     }
 
-    iterator insert(iterator pos, const T& value) {
+    // Constructs the element in place when it lands at the end or the
+    // vector has to reallocate anyway. Otherwise it is built in a temporary
+    // (args may refer to an element that is about to shift) and moved in.
+    template <class... Args>
+    iterator emplace(iterator pos, Args&&... args) {
         typename iterator::difference_type loc = pos - begin();
-        if (loc >= _size) {
+        if (loc < 0 || static_cast<size_t>(loc) > _size) {
             throw std::out_of_range("");
         }
         if (_size == _capacity) {
-            grow();
+            _grow_insert(loc, std::forward<Args>(args)...);
         }
-        _size += 1;
-        for (auto i = _size-1; i > loc; i--) {
-            array[i] = std::move(array[i-1]);
+        else if (static_cast<size_t>(loc) == _size) {
+            alloc_traits::construct(_alloc, array + _size, std::forward<Args>(args)...);
+            _size += 1;
         }
-        array[loc] = value;
-        pos = begin();
-        pos += loc;
-        return pos;
+        else {
+            T hold(std::forward<Args>(args)...);
+            _open_gap(loc);
+            if constexpr (_relocatable) {
+                alloc_traits::construct(_alloc, array + loc, std::move(hold));
+            }
+            else {
+                array[loc] = std::move(hold);
+            }
+            _size += 1;
+        }
+        return iterator(array + loc);
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        return emplace(pos, value);
     }
     iterator insert(iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+    iterator insert(iterator pos, size_t count, const T& value) {
         typename iterator::difference_type loc = pos - begin();
-        if (loc >= _size) {
+        if (loc < 0 || static_cast<size_t>(loc) > _size) {
             throw std::out_of_range("");
         }
-        if (_size == _capacity) {
-            grow();
+        // value may be one of the elements that is about to move
+        if (count != 0 && &value >= array && &value < array + _size) {
+            T hold(value);
+            _insert_n(loc, count, _repeat{&hold});
         }
-        _size += 1;
-        for (auto i = _size-1; i > loc; i--) {
-            array[i] = std::move(array[i-1]);
+        else {
+            _insert_n(loc, count, _repeat{&value});
         }
-        array[loc] = std::move(value);
-        pos = begin();
-        pos += loc;
-        return pos;
+        return iterator(array + loc);
     }
-    iterator insert(iterator pos, size_t count, const T& value) {
-        for (auto i = 0; i < count; i++) {
-            pos = insert(pos, value);
+    // The range must not come from this vector. Ranges that can be measured
+    // are inserted with at most one reallocation and a single shift of the
+    // tail; single pass ranges are appended and then rotated into place.
+    template <class InputIt, class = _require_iterator<InputIt>>
+    iterator insert(iterator pos, InputIt first, InputIt last) {
+        typename iterator::difference_type loc = pos - begin();
+        if (loc < 0 || static_cast<size_t>(loc) > _size) {
+            throw std::out_of_range("");
         }
-        return pos;
+        if constexpr (_is_forward<InputIt>) {
+            _insert_n(loc, std::distance(first, last), first);
+        }
+        else {
+            size_t old_size = _size;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(array + loc, array + old_size, array + _size);
+        }
+        return iterator(array + loc);
     }
     iterator erase(iterator pos) {
         typename iterator::difference_type loc = pos - begin();
-        if (loc >= _size) {
+        if (loc < 0 || static_cast<size_t>(loc) >= _size) {
             throw std::out_of_range("");
         }
-        for (auto i = loc; i < _size-1; i++) {
-            array[i] = std::move(array[i+1]);
+        if constexpr (_relocatable) {
+            alloc_traits::destroy(_alloc, array + loc);
+            _relocate(array + loc, array + loc + 1, _size - loc - 1);
+            _size -= 1;
+        }
+        else {
+            for (size_t i = loc; i < _size - 1; i++) {
+                array[i] = std::move(array[i + 1]);
+            }
+            pop_back();
         }
-        pop_back();
         return pos;
     }
     iterator erase(iterator first, iterator last) {
-        typename iterator::difference_type len = last - first;
-        typename iterator::difference_type start = first - begin();
-        typename iterator::difference_type end = last - begin();
-        for (auto i = 0; i < _size; i++) {
-            if (end+i > _size-1) {
-                break;
+        size_t start = first - begin();
+        size_t end = last - begin();
+        size_t len = end - start;
+        if (len == 0) {
+            // nothing to erase, and moving each element onto itself is not
+            // a no-op for every type
+            return first;
+        }
+        if constexpr (_relocatable) {
+            _destroy(array + start, array + end);
+            _relocate(array + start, array + end, _size - end);
+        }
+        else {
+            for (size_t i = end; i < _size; i++) {
+                array[i - len] = std::move(array[i]);
             }
-            array[start+i] = std::move(array[end+i]);
+            _destroy(array + _size - len, array + _size);
         }
         _size -= len;
-        iterator pos = begin();
-        pos += start;
-        return pos;
+        return iterator(array + start);
     }
 
     class iterator {
@@ -359,12 +809,13 @@ public:
 
 
     void clear() noexcept {
+        _destroy(array, array + _size);
         _size = 0;
     }
 };
 
-template <class T>
-[[nodiscard]] typename Vector<T>::iterator operator+(typename Vector<T>::iterator::difference_type offset, typename Vector<T>::iterator iterator) noexcept {
+template <class T, class Allocator, class GrowthPolicy>
+[[nodiscard]] typename Vector<T, Allocator, GrowthPolicy>::iterator operator+(typename Vector<T, Allocator, GrowthPolicy>::iterator::difference_type offset, typename Vector<T, Allocator, GrowthPolicy>::iterator iterator) noexcept {
     return iterator + offset;
 }
 
@@ -0,0 +1,549 @@
+#ifndef VECTOR_ALGORITHMS_H
+#define VECTOR_ALGORITHMS_H
+
+#include <algorithm> // std::min_element, std::max_element
+#include <cstddef> // size_t
+#include <cstdint> // int32_t, int64_t
+#include <type_traits> // std::is_arithmetic, std::conditional_t
+
+#include "Vector.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Scans over Vectors of arithmetic types: find, count, min_element,
+// max_element and sum. Vectors of int and float run SSE2 or AVX2 kernels
+// chosen at runtime from what the CPU supports. Other arithmetic types, and
+// builds for other architectures, run the scalar loops.
+//
+// The results match the std algorithms, except for two float cases. sum
+// adds in a different order, so the last bits can differ. min/max of a
+// range containing NaN may point at a different element than the std
+// algorithms would, but always at an element of the range.
+
+namespace simd {
+
+enum class Isa { scalar, sse2, avx2 };
+
+// Best instruction set the running CPU supports
+inline Isa detect_isa() noexcept {
+#ifdef VECTOR_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Isa::sse2;
+    }
+#endif
+    return Isa::scalar;
+}
+
+inline Isa& _isa() noexcept {
+    static Isa isa = detect_isa();
+    return isa;
+}
+
+inline Isa active_isa() noexcept {
+    return _isa();
+}
+
+// Caps the kernels at isa, e.g. to compare a SIMD path against the scalar
+// one. Requests beyond what the CPU supports are clamped.
+inline void force_isa(Isa isa) noexcept {
+    Isa best = detect_isa();
+    _isa() = isa < best ? isa : best;
+}
+
+// Integer sums widen so they do not overflow, float sums keep their type
+template <class T>
+using sum_type = std::conditional_t<std::is_integral<T>::value, long long, T>;
+
+/*
+    Scalar kernels, also used for the tails the vector loops leave over
+*/
+
+template <class T>
+size_t find(const T* data, size_t n, T value) noexcept {
+    for (size_t i = 0; i < n; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <class T>
+size_t count(const T* data, size_t n, T value) noexcept {
+    size_t hits = 0;
+    for (size_t i = 0; i < n; i++) {
+        hits += data[i] == value;
+    }
+    return hits;
+}
+
+// Folds [data, data + n) into lo/hi, which hold valid starting values
+template <class T>
+void minmax(const T* data, size_t n, T& lo, T& hi) noexcept {
+    for (size_t i = 0; i < n; i++) {
+        if (data[i] < lo) {
+            lo = data[i];
+        }
+        if (hi < data[i]) {
+            hi = data[i];
+        }
+    }
+}
+
+template <class T>
+sum_type<T> sum(const T* data, size_t n) noexcept {
+    sum_type<T> total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += data[i];
+    }
+    return total;
+}
+
+#ifdef VECTOR_SIMD_X86
+
+/*
+    SSE2 kernels, 4 lanes
+*/
+
+__attribute__((target("sse2"))) inline size_t _find_sse2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(data + i);
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128(p), needle);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), needle);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), needle);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), needle);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline size_t _find_sse2(const float* data, size_t n, float value) noexcept {
+    const __m128 needle = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128 a = _mm_cmpeq_ps(_mm_loadu_ps(data + i), needle);
+        __m128 b = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 4), needle);
+        __m128 c = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 8), needle);
+        __m128 d = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 12), needle);
+        if (_mm_movemask_ps(_mm_or_ps(_mm_or_ps(a, b), _mm_or_ps(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find(data + i, n - i, value);
+}
+
+// Lane counters are flushed every block so they can not overflow
+__attribute__((target("sse2"))) inline size_t _count_sse2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m128i needle = _mm_set1_epi32(value);
+    const size_t block = size_t(1) << 24;
+    size_t hits = 0;
+    size_t i = 0;
+    while (i + 4 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        size_t stop = n - i > block ? i + block : n;
+        for (; i + 4 <= stop; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(v, needle));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        hits += size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return hits + count(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline size_t _count_sse2(const float* data, size_t n, float value) noexcept {
+    const __m128 needle = _mm_set1_ps(value);
+    const size_t block = size_t(1) << 24;
+    size_t hits = 0;
+    size_t i = 0;
+    while (i + 4 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        size_t stop = n - i > block ? i + block : n;
+        for (; i + 4 <= stop; i += 4) {
+            __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(data + i), needle);
+            acc = _mm_sub_epi32(acc, _mm_castps_si128(eq));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        hits += size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return hits + count(data + i, n - i, value);
+}
+
+// SSE2 has no 32-bit integer min/max, so they are built from a compare
+__attribute__((target("sse2"))) inline void _minmax_sse2(const int32_t* data, size_t n, int32_t& lo, int32_t& hi) noexcept {
+    size_t i = 0;
+    if (n >= 4) {
+        __m128i vlo = _mm_set1_epi32(lo);
+        __m128i vhi = _mm_set1_epi32(hi);
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i lt = _mm_cmpgt_epi32(vlo, v);
+            __m128i gt = _mm_cmpgt_epi32(v, vhi);
+            vlo = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, vlo));
+            vhi = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, vhi));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vlo);
+        minmax(lanes, 4, lo, hi);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vhi);
+        minmax(lanes, 4, lo, hi);
+    }
+    minmax(data + i, n - i, lo, hi);
+}
+
+__attribute__((target("sse2"))) inline void _minmax_sse2(const float* data, size_t n, float& lo, float& hi) noexcept {
+    size_t i = 0;
+    if (n >= 4) {
+        __m128 vlo = _mm_set1_ps(lo);
+        __m128 vhi = _mm_set1_ps(hi);
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(data + i);
+            vlo = _mm_min_ps(vlo, v);
+            vhi = _mm_max_ps(vhi, v);
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, vlo);
+        minmax(lanes, 4, lo, hi);
+        _mm_store_ps(lanes, vhi);
+        minmax(lanes, 4, lo, hi);
+    }
+    minmax(data + i, n - i, lo, hi);
+}
+
+// Widens to 64-bit lanes by interleaving each value with its sign
+__attribute__((target("sse2"))) inline long long _sum_sse2(const int32_t* data, size_t n) noexcept {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sum(data + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline float _sum_sse2(const float* data, size_t n) noexcept {
+    __m128 a = _mm_setzero_ps();
+    __m128 b = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = _mm_add_ps(a, _mm_loadu_ps(data + i));
+        b = _mm_add_ps(b, _mm_loadu_ps(data + i + 4));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(a, b));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + sum(data + i, n - i);
+}
+
+/*
+    AVX2 kernels, 8 lanes
+*/
+
+__attribute__((target("avx2"))) inline size_t _find_avx2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i* p = reinterpret_cast<const __m256i*>(data + i);
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256(p), needle);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), needle);
+        __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), needle);
+        __m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t _find_avx2(const float* data, size_t n, float value) noexcept {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 a = _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ);
+        __m256 b = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 8), needle, _CMP_EQ_OQ);
+        __m256 c = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 16), needle, _CMP_EQ_OQ);
+        __m256 d = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 24), needle, _CMP_EQ_OQ);
+        if (_mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(a, b), _mm256_or_ps(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t _count_avx2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m256i needle = _mm256_set1_epi32(value);
+    const size_t block = size_t(1) << 24;
+    size_t hits = 0;
+    size_t i = 0;
+    while (i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t stop = n - i > block ? i + block : n;
+        for (; i + 8 <= stop; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(v, needle));
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (int32_t lane : lanes) {
+            hits += size_t(lane);
+        }
+    }
+    return hits + count(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t _count_avx2(const float* data, size_t n, float value) noexcept {
+    const __m256 needle = _mm256_set1_ps(value);
+    const size_t block = size_t(1) << 24;
+    size_t hits = 0;
+    size_t i = 0;
+    while (i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t stop = n - i > block ? i + block : n;
+        for (; i + 8 <= stop; i += 8) {
+            __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ);
+            acc = _mm256_sub_epi32(acc, _mm256_castps_si256(eq));
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (int32_t lane : lanes) {
+            hits += size_t(lane);
+        }
+    }
+    return hits + count(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline void _minmax_avx2(const int32_t* data, size_t n, int32_t& lo, int32_t& hi) noexcept {
+    size_t i = 0;
+    if (n >= 8) {
+        __m256i vlo = _mm256_set1_epi32(lo);
+        __m256i vhi = _mm256_set1_epi32(hi);
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            vlo = _mm256_min_epi32(vlo, v);
+            vhi = _mm256_max_epi32(vhi, v);
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vlo);
+        minmax(lanes, 8, lo, hi);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vhi);
+        minmax(lanes, 8, lo, hi);
+    }
+    minmax(data + i, n - i, lo, hi);
+}
+
+__attribute__((target("avx2"))) inline void _minmax_avx2(const float* data, size_t n, float& lo, float& hi) noexcept {
+    size_t i = 0;
+    if (n >= 8) {
+        __m256 vlo = _mm256_set1_ps(lo);
+        __m256 vhi = _mm256_set1_ps(hi);
+        for (; i + 8 <= n; i += 8) {
+            __m256 v = _mm256_loadu_ps(data + i);
+            vlo = _mm256_min_ps(vlo, v);
+            vhi = _mm256_max_ps(vhi, v);
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, vlo);
+        minmax(lanes, 8, lo, hi);
+        _mm256_store_ps(lanes, vhi);
+        minmax(lanes, 8, lo, hi);
+    }
+    minmax(data + i, n - i, lo, hi);
+}
+
+__attribute__((target("avx2"))) inline long long _sum_avx2(const int32_t* data, size_t n) noexcept {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline float _sum_avx2(const float* data, size_t n) noexcept {
+    __m256 a = _mm256_setzero_ps();
+    __m256 b = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a = _mm256_add_ps(a, _mm256_loadu_ps(data + i));
+        b = _mm256_add_ps(b, _mm256_loadu_ps(data + i + 8));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(a, b));
+    float total = 0;
+    for (float lane : lanes) {
+        total += lane;
+    }
+    return total + sum(data + i, n - i);
+}
+
+/*
+    Dispatch, these overloads win over the scalar templates for int/float
+*/
+
+inline size_t find(const int32_t* data, size_t n, int32_t value) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _find_avx2(data, n, value);
+    case Isa::sse2: return _find_sse2(data, n, value);
+    default: return find<int32_t>(data, n, value);
+    }
+}
+inline size_t find(const float* data, size_t n, float value) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _find_avx2(data, n, value);
+    case Isa::sse2: return _find_sse2(data, n, value);
+    default: return find<float>(data, n, value);
+    }
+}
+
+inline size_t count(const int32_t* data, size_t n, int32_t value) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _count_avx2(data, n, value);
+    case Isa::sse2: return _count_sse2(data, n, value);
+    default: return count<int32_t>(data, n, value);
+    }
+}
+inline size_t count(const float* data, size_t n, float value) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _count_avx2(data, n, value);
+    case Isa::sse2: return _count_sse2(data, n, value);
+    default: return count<float>(data, n, value);
+    }
+}
+
+inline void minmax(const int32_t* data, size_t n, int32_t& lo, int32_t& hi) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: _minmax_avx2(data, n, lo, hi); break;
+    case Isa::sse2: _minmax_sse2(data, n, lo, hi); break;
+    default: minmax<int32_t>(data, n, lo, hi); break;
+    }
+}
+inline void minmax(const float* data, size_t n, float& lo, float& hi) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: _minmax_avx2(data, n, lo, hi); break;
+    case Isa::sse2: _minmax_sse2(data, n, lo, hi); break;
+    default: minmax<float>(data, n, lo, hi); break;
+    }
+}
+
+inline long long sum(const int32_t* data, size_t n) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _sum_avx2(data, n);
+    case Isa::sse2: return _sum_sse2(data, n);
+    default: return sum<int32_t>(data, n);
+    }
+}
+inline float sum(const float* data, size_t n) noexcept {
+    switch (active_isa()) {
+    case Isa::avx2: return _sum_avx2(data, n);
+    case Isa::sse2: return _sum_sse2(data, n);
+    default: return sum<float>(data, n);
+    }
+}
+
+#endif
+
+} // namespace simd
+
+/*
+    Vector front ends
+*/
+
+template <class T, class Allocator, class GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator find(Vector<T, Allocator, GrowthPolicy>& vec, const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "find(Vector) is for arithmetic element types, use std::find otherwise");
+    return vec.begin() + simd::find(vec.data(), vec.size(), value);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+size_t count(const Vector<T, Allocator, GrowthPolicy>& vec, const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "count(Vector) is for arithmetic element types, use std::count otherwise");
+    return simd::count(vec.data(), vec.size(), value);
+}
+
+// First smallest element, end() if vec is empty
+template <class T, class Allocator, class GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator min_element(Vector<T, Allocator, GrowthPolicy>& vec) {
+    static_assert(std::is_arithmetic<T>::value, "min_element(Vector) is for arithmetic element types, use std::min_element otherwise");
+    if (vec.empty()) {
+        return vec.end();
+    }
+    T lo = vec[0], hi = vec[0];
+    simd::minmax(vec.data(), vec.size(), lo, hi);
+    size_t i = simd::find(vec.data(), vec.size(), lo);
+    // a NaN that reached lo equals nothing, not even itself
+    if (i == vec.size()) {
+        i = std::min_element(vec.data(), vec.data() + vec.size()) - vec.data();
+    }
+    return vec.begin() + i;
+}
+
+// First largest element, end() if vec is empty
+template <class T, class Allocator, class GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::iterator max_element(Vector<T, Allocator, GrowthPolicy>& vec) {
+    static_assert(std::is_arithmetic<T>::value, "max_element(Vector) is for arithmetic element types, use std::max_element otherwise");
+    if (vec.empty()) {
+        return vec.end();
+    }
+    T lo = vec[0], hi = vec[0];
+    simd::minmax(vec.data(), vec.size(), lo, hi);
+    size_t i = simd::find(vec.data(), vec.size(), hi);
+    // as in min_element, for a NaN in hi
+    if (i == vec.size()) {
+        i = std::max_element(vec.data(), vec.data() + vec.size()) - vec.data();
+    }
+    return vec.begin() + i;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+simd::sum_type<T> sum(const Vector<T, Allocator, GrowthPolicy>& vec) {
+    static_assert(std::is_arithmetic<T>::value, "sum(Vector) is for arithmetic element types");
+    return simd::sum(vec.data(), vec.size());
+}
+
+#endif
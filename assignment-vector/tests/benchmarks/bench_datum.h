@@ -0,0 +1,27 @@
+#pragma once
+
+// What the Datum benchmarks share
+
+#include <cstdio>
+#include <string>
+
+#include "xoshiro256.h"
+
+// A feed of about bytes bytes shaped like covid-weekly-fall2021.csv, the
+// same for the same size
+inline std::string generate(size_t bytes) {
+    static const char * months[] = { "Aug", "Sept", "Oct", "Nov", "Dec" };
+    xoshiro256 rng(bytes);
+    std::string csv = "week ending,negative,positive,total,positivity (%)\n";
+    char line[128];
+    while (csv.size() < bytes) {
+        unsigned int neg = rng() % 30000;
+        unsigned int pos = rng() % 2000;
+        unsigned int tot = neg + pos;
+        double positivity = tot == 0 ? 0.0 : pos * 100.0 / tot;
+        int n = std::snprintf(line, sizeof(line), "%s %u,%u,%u,%u,%.1f%%\n",
+                              months[rng() % 5], static_cast<unsigned int>(rng() % 30 + 1), neg, pos, tot, positivity);
+        csv.append(line, n);
+    }
+    return csv;
+}
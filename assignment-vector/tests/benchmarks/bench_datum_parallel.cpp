@@ -0,0 +1,52 @@
+// Scaling of readDataParallel with the thread count against readData
+// followed by a separate badDataEntries pass, on a generated feed shaped
+// like covid-weekly-fall2021.csv. Speedups are bounded by the number of
+// cores, which is printed first.
+//
+// Usage: bench_datum_parallel [megabytes] [max threads]    (default 256 16)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Datum.h"
+#include "bench_datum.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char ** argv) {
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    std::string csv = generate(megabytes * 1000000);
+
+    std::printf("%zu MB of CSV, %u cores\n", csv.size() / 1000000, std::thread::hardware_concurrency());
+    std::printf("%-24s %10s %10s %8s\n", "loader", "rows", "MB/s", "speedup");
+
+    std::istringstream in(csv);
+    auto start = Clock::now();
+    Vector<Datum> rows = readData(in);
+    size_t bad = badDataEntries(rows).size();
+    double base = seconds_since(start);
+    std::printf("%-24s %10zu %10.1f %8.2f\n", "readData+badDataEntries", rows.size(), csv.size() / base / 1e6, 1.0);
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        start = Clock::now();
+        DatumFile file = readDataParallel(csv, threads);
+        double seconds = seconds_since(start);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "parallel x%zu", threads);
+        std::printf("%-24s %10zu %10.1f %8.2f\n", name, file.rows.size(), csv.size() / seconds / 1e6, base / seconds);
+        if (file.rows.size() != rows.size() || file.bad.size() != bad)
+            std::printf("results differ from readData\n");
+    }
+
+    return 0;
+}
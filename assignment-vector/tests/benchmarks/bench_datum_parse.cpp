@@ -0,0 +1,75 @@
+// Throughput of readData against the original getline/stringstream/stoi
+// reader on a generated feed shaped like covid-weekly-fall2021.csv.
+//
+// Usage: bench_datum_parse [megabytes]    (default 64)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "Datum.h"
+#include "bench_datum.h"
+#include "memhook.h"
+
+using Clock = std::chrono::steady_clock;
+
+// The reader readData replaced, kept here as the baseline
+static Vector<Datum> legacyReadData(std::istream& file) {
+    std::string hold = "";
+    std::getline(file,hold);
+    Vector<Datum> vec;
+    while (getline(file,hold)) {
+        std::stringstream ss(hold);
+        std::string date = "";
+        std::getline(ss,date,',');
+        std::string neg = "";
+        std::getline(ss,neg,',');
+        std::string pos = "";
+        std::getline(ss,pos,',');
+        std::string tot = "";
+        std::getline(ss,tot,',');
+        std::string percent = "";
+        std::getline(ss,percent,',');
+        Datum& row = vec.emplace_back();
+        row.week = std::move(date);
+        row.negative = std::stoi(neg);
+        row.positive = std::stoi(pos);
+        row.total = std::stoi(tot);
+        row.positivity = std::stof(percent);
+    }
+    return vec;
+}
+
+// Memhook keeps every block it sees alive, so allocations are counted on
+// a small sample and the timed run is left untracked
+template <typename Reader>
+static void run(const char * name, const std::string & csv, const std::string & sample, Reader reader) {
+    size_t allocs, sample_rows;
+    {
+        std::istringstream in(sample);
+        Memhook mh;
+        sample_rows = reader(in).size();
+        allocs = mh.n_allocs();
+    }
+
+    std::istringstream in(csv);
+    auto start = Clock::now();
+    Vector<Datum> rows = reader(in);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("%-12s %10zu rows %10.1f MB/s %10.2f allocations/row\n",
+                name, rows.size(), csv.size() / seconds / 1e6, static_cast<double>(allocs) / sample_rows);
+}
+
+int main(int argc, char ** argv) {
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    std::string csv = generate(megabytes * 1000000);
+    std::string sample = generate(1000000);
+
+    std::printf("%zu MB of CSV\n", csv.size() / 1000000);
+    run("stringstream", csv, sample, legacyReadData);
+    run("readData", csv, sample, [](std::istream & in) { return readData(in); });
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Reports how many reallocations each growth policy (and an up front
+// reserve) costs for a bulk push_back load, along with the peak number
+// of bytes held by the vector. A reallocation briefly holds both the old
+// and the new buffer, which is what the peak measures.
+//
+// Usage: bench_vector_growth [elements]    (default 10,000,000)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "memhook.h"
+#include "Vector.h"
+
+struct Result {
+    size_t reallocs;
+    size_t peak_bytes;
+    size_t final_capacity;
+    double ms;
+};
+
+template <typename Policy>
+static Result load(size_t n, bool reserve) {
+    Result r{0, 0, 0, 0.0};
+    Memhook mh;
+    auto start = std::chrono::steady_clock::now();
+    {
+        Vector<int, std::allocator<int>, Policy> vec;
+        if(reserve) {
+            vec.reserve(n);
+            r.peak_bytes = mh.last_alloc().size;
+        }
+
+        size_t seen_allocs = mh.n_allocs();
+        for(size_t i = 0; i < n; i++) {
+            vec.push_back(static_cast<int>(i));
+
+            if(mh.n_allocs() != seen_allocs) {
+                seen_allocs = mh.n_allocs();
+                size_t held = mh.last_alloc().size;
+                // the old buffer is alive until the elements are moved out
+                if(mh.n_frees() != 0)
+                    held += mh.last_free().size;
+                if(held > r.peak_bytes)
+                    r.peak_bytes = held;
+            }
+        }
+        r.final_capacity = vec.capacity();
+    }
+    r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    // the reserve is not a reallocation of existing elements
+    r.reallocs = mh.n_allocs() - (reserve ? 1 : 0);
+    return r;
+}
+
+static void report(const char * name, const Result & r) {
+    std::printf("%-22s %10zu %16zu %16zu %10.1f\n",
+        name, r.reallocs, r.peak_bytes, r.final_capacity, r.ms);
+}
+
+int main(int argc, char ** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::printf("push_back of %zu ints\n", n);
+    std::printf("%-22s %10s %16s %16s %10s\n", "policy", "reallocs", "peak bytes", "capacity", "ms");
+    report("doubling",           load<DoublingGrowth>(n, false));
+    report("1.5x",               load<HalfGrowth>(n, false));
+    report("chunk (65536)",      load<ChunkGrowth<65536>>(n, false));
+    report("reserve + doubling", load<DoublingGrowth>(n, true));
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Compares the memmove/memcpy path for trivially relocatable types with
+// the element-by-element move loops. Each pair of element types is
+// identical apart from the trait: a plain int, where the optimizer may
+// already turn the loops into memmove, and a handle with a non-trivial
+// move (like unique_ptr) that has to opt in explicitly.
+//
+// Usage: bench_vector_relocate [size ...]    (default 1000 1000000 100000000)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include "Vector.h"
+
+struct Fast {
+    int v;
+};
+
+struct Slow {
+    int v;
+};
+
+template <> struct is_trivially_relocatable<Slow> : std::false_type {};
+
+// Moving leaves the source empty, so the loops can not be vectorized
+template <bool OptIn>
+struct Handle {
+    int v;
+
+    Handle(int v) noexcept : v{v} {}
+    Handle(Handle && other) noexcept : v{other.v} { other.v = -1; }
+    Handle & operator=(Handle && other) noexcept {
+        v = other.v;
+        other.v = -1;
+        return *this;
+    }
+    ~Handle() {}
+};
+
+template <> struct is_trivially_relocatable<Handle<true>> : std::true_type {};
+
+struct Timing {
+    double grow_ns;   // per push_back, including reallocations
+    double insert_ns; // per insert at the front
+    double erase_ns;  // per erase(first, last) of one element at the front
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+template <typename E>
+static Timing run(size_t n, size_t reps) {
+    Timing r{0, 0, 0};
+    Vector<E> vec;
+
+    auto start = Clock::now();
+    for(size_t i = 0; i < n; i++)
+        vec.push_back(E{static_cast<int>(i)});
+    r.grow_ns = elapsed_ns(start) / n;
+
+    vec.reserve(n + reps);
+
+    start = Clock::now();
+    for(size_t i = 0; i < reps; i++)
+        vec.insert(vec.begin(), E{static_cast<int>(i)});
+    r.insert_ns = elapsed_ns(start) / reps;
+
+    start = Clock::now();
+    for(size_t i = 0; i < reps; i++)
+        vec.erase(vec.begin(), vec.begin() + 1);
+    r.erase_ns = elapsed_ns(start) / reps;
+
+    // keep the work observable
+    if(vec[n / 2].v != static_cast<int>(n / 2))
+        std::printf("unexpected contents\n");
+
+    return r;
+}
+
+static void report(size_t n, size_t reps, const char * path, const Timing & t) {
+    std::printf("%12zu %8zu %-16s %14.2f %14.1f %14.1f\n", n, reps, path, t.grow_ns, t.insert_ns, t.erase_ns);
+}
+
+int main(int argc, char ** argv) {
+    std::vector<size_t> sizes;
+    for(int i = 1; i < argc; i++)
+        sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if(sizes.empty())
+        sizes = {1000, 1000000, 100000000};
+
+    std::printf("%12s %8s %-16s %14s %14s %14s\n", "elements", "reps", "path", "push_back ns", "insert ns", "erase ns");
+    for(size_t n : sizes) {
+        // roughly a billion shifted elements per measurement
+        size_t reps = 1000000000 / n;
+        reps = reps < 1 ? 1 : reps > 1000 ? 1000 : reps;
+
+        report(n, reps, "int memmove", run<Fast>(n, reps));
+        report(n, reps, "int loop", run<Slow>(n, reps));
+        report(n, reps, "handle memmove", run<Handle<true>>(n, reps));
+        report(n, reps, "handle loop", run<Handle<false>>(n, reps));
+    }
+
+    return 0;
+}
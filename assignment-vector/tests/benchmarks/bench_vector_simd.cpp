@@ -0,0 +1,79 @@
+// Compares the std algorithms over Vector<int> iterators with the
+// VectorAlgorithms.h scans, once per instruction set the CPU supports.
+// find searches for a value that is not present so it scans everything.
+//
+// Usage: bench_vector_simd [elements] [repetitions]    (default 10,000,000 x 20)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+#include "VectorAlgorithms.h"
+#include "xoshiro256.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Milliseconds per call, averaged over reps
+template <typename F>
+static double time_ms(size_t reps, F f) {
+    long long sink = 0;
+    auto start = Clock::now();
+    for(size_t r = 0; r < reps; r++)
+        sink += static_cast<long long>(f());
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / reps;
+    // keep the calls from being optimized away
+    if(sink == 42)
+        std::printf(" ");
+    return ms;
+}
+
+static void report(const char * name, double ms, size_t n, double baseline) {
+    double gbs = n * sizeof(int) / (ms * 1e6);
+    std::printf("%-24s %10.3f ms %8.2f GB/s %8.2fx\n", name, ms, gbs, baseline / ms);
+}
+
+int main(int argc, char ** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t reps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    Vector<int> vec(n);
+    xoshiro256 rng(n);
+    for(size_t i = 0; i < n; i++)
+        vec[i] = static_cast<int>(rng() % 1000000);
+    const int absent = -1;
+
+    std::printf("%zu ints, %zu repetitions\n", n, reps);
+
+    double std_find = time_ms(reps, [&] { return std::find(vec.begin(), vec.end(), absent) - vec.begin(); });
+    double std_count = time_ms(reps, [&] { return std::count(vec.begin(), vec.end(), 7); });
+    double std_min = time_ms(reps, [&] { return std::min_element(vec.begin(), vec.end()) - vec.begin(); });
+    double std_max = time_ms(reps, [&] { return std::max_element(vec.begin(), vec.end()) - vec.begin(); });
+    double std_sum = time_ms(reps, [&] { return std::accumulate(vec.begin(), vec.end(), 0LL); });
+
+    std::printf("\nstd algorithms\n");
+    report("std::find", std_find, n, std_find);
+    report("std::count", std_count, n, std_count);
+    report("std::min_element", std_min, n, std_min);
+    report("std::max_element", std_max, n, std_max);
+    report("std::accumulate", std_sum, n, std_sum);
+
+    const simd::Isa isas[] = { simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2 };
+    const char * names[] = { "scalar", "sse2", "avx2" };
+
+    for(size_t k = 0; k < 3; k++) {
+        if(simd::detect_isa() < isas[k])
+            break;
+        simd::force_isa(isas[k]);
+
+        std::printf("\n%s (speedup over std)\n", names[k]);
+        report("find", time_ms(reps, [&] { return find(vec, absent) - vec.begin(); }), n, std_find);
+        report("count", time_ms(reps, [&] { return count(vec, 7); }), n, std_count);
+        report("min_element", time_ms(reps, [&] { return min_element(vec) - vec.begin(); }), n, std_min);
+        report("max_element", time_ms(reps, [&] { return max_element(vec) - vec.begin(); }), n, std_max);
+        report("sum", time_ms(reps, [&] { return sum(vec); }), n, std_sum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "executable.h"
+#include "datum_utils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Large enough that every thread gets a range of its own
+static std::vector<DatumGT> generate_large(Typegen & t) {
+    std::vector<DatumGT> gt_data(t.range<size_t>(20000, 30000));
+    for(DatumGT & gt : gt_data)
+        gt = DatumGT::generate(t);
+    return gt_data;
+}
+
+// True when file holds the rows of gt_data and lists exactly the rows
+// that fail validation. Printing rounds positivity, which can move a row
+// across the 0.1 margin, so bad rows are judged on the values read back.
+static bool matches(std::vector<DatumGT> const & gt_data, DatumFile const & file) {
+    if(gt_data.size() != file.rows.size())
+        return false;
+
+    size_t next = 0;
+    for(size_t i = 0; i < gt_data.size(); i++) {
+        Datum const & datum = file.rows[i];
+        Datum const & gt_datum = gt_data[i].datum;
+
+        if(gt_datum.week != datum.week || gt_datum.negative != datum.negative
+           || gt_datum.positive != datum.positive || gt_datum.total != datum.total
+           || std::fabs(gt_datum.positivity - datum.positivity) > 1e-2)
+            return false;
+
+        if(isBadDataEntry(datum) && (next == file.bad.size() || file.bad[next++] != i))
+            return false;
+    }
+    return next == file.bad.size();
+}
+
+TEST(datum_read_parallel) {
+    Typegen t;
+
+    for(size_t threads : {1UL, 2UL, 3UL, 8UL, 0UL}) {
+        std::vector<DatumGT> gt_data = generate_large(t);
+
+        std::stringstream ss;
+        ss << gt_data;
+        std::string csv = ss.str();
+
+        ASSERT_TRUE(matches(gt_data, readDataParallel(csv, threads)));
+    }
+
+    // small files and an empty one
+    for(int i = 0; i < 50; i++) {
+        std::vector<DatumGT> gt_data = generate_file_data(t);
+
+        std::stringstream ss;
+        ss << gt_data;
+
+        ASSERT_TRUE(matches(gt_data, readDataParallel(ss.str(), 4)));
+    }
+    ASSERT_TRUE(readDataParallel("", 4).rows.empty());
+}
+
+#if !defined(_WIN32)
+TEST(datum_read_parallel_file) {
+    Typegen t;
+
+    std::vector<DatumGT> gt_data = generate_large(t);
+    std::string path = "datum_read_parallel.csv";
+    {
+        std::ofstream out(path);
+        out << gt_data;
+    }
+
+    ASSERT_TRUE(matches(gt_data, readFileParallel(path, 4)));
+
+    std::remove(path.c_str());
+}
+#endif
+
+TEST(datum_read_parallel_malformed) {
+    Typegen t;
+
+    std::vector<DatumGT> gt_data = generate_large(t);
+    std::stringstream ss;
+    ss << gt_data;
+    // break a row far from the first range
+    std::string csv = ss.str();
+    size_t row = csv.find('\n', csv.size() * 3 / 4);
+    csv.insert(row + 1, "Oct 3,12,x,12,0.0%\n");
+
+    bool thrown = false;
+    try {
+        DatumFile file = readDataParallel(csv, 4);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
@@ -0,0 +1,83 @@
+#include "executable.h"
+#include "datum_utils.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+TEST(datum_read_stream_chunks) {
+    Typegen t;
+
+    // tiny chunks put row boundaries everywhere, including mid number
+    for(size_t chunk : {1UL, 2UL, 7UL, 64UL, 1UL << 16}) {
+        for(int i = 0; i < 20; i++) {
+            std::vector<DatumGT> gt_data = generate_file_data(t);
+
+            std::stringstream ss;
+            ss << gt_data;
+
+            Vector<Datum> data = readData(ss, chunk);
+
+            ASSERT_EQ(gt_data.size(), data.size());
+            for(size_t i = 0; i < gt_data.size(); i++) {
+                Datum const & datum = data[i];
+                Datum const & gt_datum = gt_data[i].datum;
+
+                ASSERT_TRUE(gt_datum.week == datum.week);
+                ASSERT_EQ(gt_datum.negative,   datum.negative);
+                ASSERT_EQ(gt_datum.positive,   datum.positive);
+                ASSERT_EQ(gt_datum.total,      datum.total);
+                ASSERT_NEAR(gt_datum.positivity, datum.positivity, 1e-2);
+            }
+        }
+    }
+}
+
+TEST(datum_read_stream_line_endings) {
+    // windows line endings and no newline after the last row
+    std::stringstream ss("week ending,negative,positive,total,positivity (%)\r\n"
+                         "Aug 21,2207,139,2346,5.9%\r\n"
+                         "\r\n"
+                         "Sept 4,21129,1116,22245,5.0%");
+
+    Vector<Datum> data = readData(ss, 8);
+
+    ASSERT_EQ(2UL, data.size());
+    ASSERT_TRUE(data[0].week == "Aug 21");
+    ASSERT_EQ(2346U, data[0].total);
+    ASSERT_NEAR(5.9f, data[0].positivity, 1e-4);
+    ASSERT_TRUE(data[1].week == "Sept 4");
+    ASSERT_EQ(21129U, data[1].negative);
+    ASSERT_NEAR(5.0f, data[1].positivity, 1e-4);
+}
+
+TEST(datum_read_stream_allocations) {
+    Typegen t;
+
+    size_t rows = 10000;
+    std::stringstream ss;
+    ss << "week ending,negative,positive,total,positivity (%)\n";
+    for(size_t i = 0; i < rows; i++)
+        ss << DatumGT::generate(t);
+
+    Memhook mh;
+    Vector<Datum> data = readData(ss);
+
+    ASSERT_EQ(rows, data.size());
+    // the chunk buffer and the Vector growing; short weeks never allocate
+    ASSERT_LT(mh.n_allocs(), 20UL);
+}
+
+TEST(datum_read_stream_malformed) {
+    std::stringstream ss("week ending,negative,positive,total,positivity (%)\n"
+                         "Aug 21,2207,,2346,5.9%\n");
+
+    bool thrown = false;
+    try {
+        Vector<Datum> data = readData(ss);
+    }
+    catch(const std::invalid_argument &) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
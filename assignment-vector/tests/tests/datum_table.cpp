@@ -0,0 +1,70 @@
+#include "executable.h"
+#include "datum_utils.h"
+
+#include "DatumTable.h"
+
+TEST(datum_table) {
+    Typegen t;
+
+    for(int i = 0; i < 100; i++) {
+        std::vector<DatumGT> gt_data = generate_file_data(t);
+        // long tables so the block boundaries in goodData are crossed
+        if(i % 10 == 0) {
+            for(size_t k = 0; k < 1000; k++)
+                gt_data.push_back(DatumGT::generate(t, true));
+        }
+        Vector<Datum> data = get_data_vector(gt_data);
+
+        DatumTable table(data);
+        ASSERT_EQ(gt_data.size(), table.size());
+
+        for(size_t i = 0; i < gt_data.size(); i++) {
+            Datum const datum = table.row(i);
+            Datum const & gt_datum = gt_data[i].datum;
+
+            ASSERT_TRUE(gt_datum.week == datum.week);
+            ASSERT_EQ(gt_datum.negative,   datum.negative);
+            ASSERT_EQ(gt_datum.positive,   datum.positive);
+            ASSERT_EQ(gt_datum.total,      datum.total);
+            ASSERT_EQ(gt_datum.positivity, datum.positivity);
+        }
+
+        Vector<unsigned char> mask = badDataMask(table);
+        Vector<size_t> indices = badDataIndices(table);
+
+        ASSERT_EQ(gt_data.size(), mask.size());
+        size_t next = 0;
+        for(size_t i = 0; i < gt_data.size(); i++) {
+            ASSERT_EQ(gt_data[i].bad, mask[i] == 1);
+            if(gt_data[i].bad) {
+                ASSERT_LT(next, indices.size());
+                ASSERT_EQ(i, indices[next++]);
+            }
+        }
+        ASSERT_EQ(next, indices.size());
+
+        ASSERT_EQ(indices.empty(), goodData(table));
+        ASSERT_EQ(goodData(data), goodData(table));
+    }
+}
+
+TEST(datum_table_good) {
+    Typegen t;
+
+    for(int i = 0; i < 100; i++) {
+        std::vector<DatumGT> gt_data = generate_file_data(t, true);
+        DatumTable table(get_data_vector(gt_data));
+
+        ASSERT_TRUE(goodData(table));
+        ASSERT_TRUE(badDataIndices(table).empty());
+
+        // a single bad row at the very end is still found
+        DatumGT bad = DatumGT::generate(t, true);
+        bad.datum.total += 1;
+        table.push_back(bad.datum);
+
+        ASSERT_FALSE(goodData(table));
+        ASSERT_EQ(1UL, badDataIndices(table).size());
+        ASSERT_EQ(table.size() - 1, badDataIndices(table)[0]);
+    }
+}
@@ -0,0 +1,145 @@
+#include "executable.h"
+
+#include <memory>
+#include <vector>
+
+// Counts every constructor and destructor so growth can be checked
+// for stray default constructions of unused capacity
+struct Tally {
+    static size_t defaults, copies, moves, destroys;
+
+    int val;
+
+    Tally() : val{0} { defaults++; }
+    Tally(int val) : val{val} {}
+    Tally(const Tally & other) : val{other.val} { copies++; }
+    Tally(Tally && other) : val{other.val} { moves++; }
+    Tally & operator=(const Tally &) = default;
+    Tally & operator=(Tally &&) = default;
+    ~Tally() { destroys++; }
+
+    static void reset() { defaults = copies = moves = destroys = 0; }
+};
+
+size_t Tally::defaults = 0;
+size_t Tally::copies = 0;
+size_t Tally::moves = 0;
+size_t Tally::destroys = 0;
+
+// Forwards to std::allocator while recording how much is outstanding
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    size_t * live;
+
+    explicit CountingAllocator(size_t * live) noexcept : live{live} {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> & other) noexcept : live{other.live} {}
+
+    T * allocate(size_t n) {
+        *live += n;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T * ptr, size_t n) noexcept {
+        *live -= n;
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    bool operator==(const CountingAllocator & other) const noexcept { return live == other.live; }
+    bool operator!=(const CountingAllocator & other) const noexcept { return live != other.live; }
+};
+
+TEST(growth_is_uninitialized) {
+    Typegen t;
+
+    for(size_t k = 0; k < 20; k++) {
+        size_t sz = t.range<size_t>(1, 0xFFF);
+        Tally::reset();
+        {
+            Vector<Tally> vec;
+            size_t expected_moves = 0;
+
+            for(size_t i = 0; i < sz; i++) {
+                if(vec.size() == vec.capacity())
+                    expected_moves += vec.size();
+                vec.push_back(Tally(static_cast<int>(i)));
+                // one more move from the temporary
+                expected_moves++;
+            }
+
+            ASSERT_EQ(0UL, Tally::defaults);
+            ASSERT_EQ(0UL, Tally::copies);
+            ASSERT_EQ(expected_moves, Tally::moves);
+
+            for(size_t i = 0; i < sz; i++)
+                ASSERT_EQ(static_cast<int>(i), vec[i].val);
+        }
+        // each temporary, each moved-from buffer slot and each live element
+        ASSERT_EQ(sz + Tally::moves, Tally::destroys);
+    }
+}
+
+TEST(fill_constructor_copies_once) {
+    Typegen t;
+
+    for(size_t k = 0; k < 20; k++) {
+        size_t sz = t.range<size_t>(0, 0xFFF);
+        Tally::reset();
+        {
+            Tally value(t.get<int>());
+            Vector<Tally> vec(sz, value);
+
+            ASSERT_EQ(0UL, Tally::defaults);
+            ASSERT_EQ(sz, Tally::copies);
+            ASSERT_EQ(0UL, Tally::moves);
+        }
+        ASSERT_EQ(sz + 1, Tally::destroys);
+    }
+}
+
+TEST(destroy_on_remove) {
+    Tally::reset();
+
+    Vector<Tally> vec(10, Tally(1));
+    size_t destroyed = Tally::destroys;
+
+    vec.pop_back();
+    ASSERT_EQ(destroyed + 1, Tally::destroys);
+
+    vec.erase(vec.begin());
+    ASSERT_EQ(destroyed + 2, Tally::destroys);
+
+    vec.erase(vec.begin(), vec.begin() + 3);
+    ASSERT_EQ(destroyed + 5, Tally::destroys);
+
+    vec.clear();
+    ASSERT_EQ(destroyed + 10, Tally::destroys);
+    ASSERT_EQ(10UL, vec.capacity());
+}
+
+TEST(custom_allocator) {
+    Typegen t;
+    size_t live = 0;
+
+    {
+        CountingAllocator<int> alloc(&live);
+        Vector<int, CountingAllocator<int>> vec(alloc);
+        std::vector<int> gt;
+
+        for(size_t i = 0; i < 1000; i++) {
+            int el = t.get<int>();
+            vec.push_back(el);
+            gt.push_back(el);
+            ASSERT_EQ(vec.capacity(), live);
+        }
+
+        Vector<int, CountingAllocator<int>> copy(vec);
+        ASSERT_EQ(vec.capacity() + copy.capacity(), live);
+
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_EQ(gt[i], copy[i]);
+    }
+
+    ASSERT_EQ(0UL, live);
+}
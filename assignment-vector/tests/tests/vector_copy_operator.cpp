@@ -1,4 +1,5 @@
 #include "executable.h"
+#include <stdexcept>
 #include <vector>
 
 TEST(copy_operator) {
@@ -93,4 +94,55 @@ TEST(copy_operator__self_copy) {
             ASSERT_EQ(gt[i], original[i]);
         }
     }
-}
\ No newline at end of file
+}
+// Throws from the copy constructor once the budget of copies runs out
+struct LimitedCopies {
+    static size_t budget;
+
+    int val;
+
+    LimitedCopies(int val) : val{val} {}
+    LimitedCopies(const LimitedCopies & other) : val{other.val} {
+        if(budget == 0)
+            throw std::runtime_error("out of copies");
+        budget--;
+    }
+    LimitedCopies & operator=(const LimitedCopies &) = default;
+};
+
+size_t LimitedCopies::budget = 0;
+
+TEST(copy_operator__throwing_copy) {
+    Typegen t;
+    for(size_t sz = 1; sz < 100; sz++) {
+        LimitedCopies::budget = size_t(-1);
+        Vector<LimitedCopies> original, copy;
+        for(size_t i = 0; i < sz; i++)
+            original.push_back(LimitedCopies(t.get<int>()));
+        size_t copy_sz = t.range<size_t>(0, 9);
+        for(size_t i = 0; i < copy_sz; i++)
+            copy.push_back(LimitedCopies(static_cast<int>(i)));
+        size_t copy_cap = copy.capacity();
+
+        // a failed copy leaves the target as it was
+        LimitedCopies::budget = t.range<size_t>(0, sz);
+        bool thrown = false;
+        try {
+            copy = original;
+        }
+        catch(const std::runtime_error &) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+        ASSERT_EQ(copy_sz, copy.size());
+        ASSERT_EQ(copy_cap, copy.capacity());
+        for(size_t i = 0; i < copy_sz; i++)
+            ASSERT_EQ(static_cast<int>(i), copy[i].val);
+
+        LimitedCopies::budget = sz;
+        copy = original;
+        ASSERT_EQ(sz, copy.size());
+        for(size_t i = 0; i < sz; i++)
+            ASSERT_EQ(original[i].val, copy[i].val);
+    }
+}
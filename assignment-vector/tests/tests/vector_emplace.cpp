@@ -0,0 +1,114 @@
+#include "executable.h"
+
+#include <string>
+#include <vector>
+
+#include "box.h"
+
+TEST(emplace_back) {
+    Typegen t;
+
+    for(int j = 0; j < 100; j++) {
+        size_t sz = t.range<size_t>(0, 0xFF);
+
+        Vector<Box<int>> vec;
+        std::vector<int> gt;
+
+        for(size_t i = 0; i < sz; i++) {
+            int el = t.get<int>();
+            gt.push_back(el);
+
+            size_t init_cap = vec.capacity();
+            {
+                Memhook mh;
+
+                // Box owns the pointer, nothing else may allocate
+                Box<int> & b = vec.emplace_back(el);
+
+                ASSERT_EQ(el, *b);
+                // one for the Box contents, one for a reallocation
+                ASSERT_EQ(1UL + (init_cap == i), mh.n_allocs());
+            }
+        }
+
+        {
+            int * raw = new int(t.get<int>());
+            gt.push_back(*raw);
+
+            Memhook mh;
+            vec.reserve(vec.size() + 1);
+            size_t allocs = mh.n_allocs();
+
+            vec.emplace_back(raw);
+
+            ASSERT_EQ(allocs, mh.n_allocs());
+        }
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_EQ(gt[i], *vec[i]);
+    }
+}
+
+TEST(emplace) {
+    Typegen t;
+
+    for(int j = 0; j < 100; j++) {
+        size_t sz = t.range<size_t>(1, 0xFFF);
+
+        Vector<Box<int>> vec(sz);
+        std::vector<int> gt(sz);
+
+        using iter = typename Vector<Box<int>>::iterator;
+
+        for(size_t i = 0; i < sz; i++)
+            vec[i] = gt[i] = t.get<int>();
+
+        int el = t.get<int>();
+        ptrdiff_t i = t.range<ptrdiff_t>(0, sz + 1);
+        gt.insert(gt.begin() + i, el);
+
+        size_t init_cap = vec.capacity();
+        {
+            Memhook mh;
+
+            iter pos = vec.emplace(vec.begin() + i, el);
+
+            ASSERT_EQ(i, static_cast<ptrdiff_t>(pos - vec.begin()));
+            // the Box contents and a reallocation if the vector was full
+            ASSERT_EQ(1UL + (sz == init_cap), mh.n_allocs());
+        }
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_EQ(gt[i], *vec[i]);
+    }
+}
+
+TEST(emplace_aliased) {
+    Typegen t;
+
+    for(int j = 0; j < 100; j++) {
+        size_t sz = t.range<size_t>(1, 0xFF);
+
+        Vector<std::string> vec;
+        std::vector<std::string> gt;
+
+        for(size_t i = 0; i < sz; i++) {
+            gt.push_back(t.get<std::string>(30));
+            vec.push_back(gt.back());
+        }
+
+        // arguments that refer into the vector itself
+        size_t from = t.range<size_t>(0, sz);
+        size_t to = t.range<size_t>(0, sz);
+        gt.push_back(gt[from]);
+        vec.emplace_back(vec[from]);
+        gt.insert(gt.begin() + to, gt[from]);
+        vec.emplace(vec.begin() + to, vec[from]);
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_TRUE(gt[i] == vec[i]);
+    }
+}
@@ -37,8 +37,9 @@ TEST(insert_multiple) {
             
             size_t wanted_allocs = 0;
             
+            // the whole batch fits after a single reallocation
             if(sz + count > init_cap) 
-                wanted_allocs = std::ceil(std::log2(static_cast<double>(init_cap + count) / static_cast<double>(init_cap)));
+                wanted_allocs = 1;
             
             // Copy in adds one copy
             wanted_allocs += count + 1;
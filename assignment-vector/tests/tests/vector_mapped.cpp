@@ -0,0 +1,114 @@
+#include "executable.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "MappedVector.h"
+
+// Writes the values as raw records and returns the file name
+static std::string write_records(const char * name, const std::vector<int> & values) {
+    std::string path = std::string("mapped_") + name + ".bin";
+    FILE * out = std::fopen(path.c_str(), "wb");
+    std::fwrite(values.data(), sizeof(int), values.size(), out);
+    std::fclose(out);
+    return path;
+}
+
+static std::vector<int> read_records(const std::string & path) {
+    std::vector<int> values;
+    FILE * in = std::fopen(path.c_str(), "rb");
+    int v;
+    while(std::fread(&v, sizeof(int), 1, in) == 1)
+        values.push_back(v);
+    std::fclose(in);
+    return values;
+}
+
+TEST(mapped_view) {
+    Typegen t;
+
+    for(size_t k = 0; k < 20; k++) {
+        size_t sz = t.range<size_t>(0, 0xFFFF);
+        std::vector<int> gt(sz);
+        for(size_t i = 0; i < sz; i++)
+            gt[i] = t.get<int>();
+        std::string path = write_records("view", gt);
+
+        {
+            Memhook mh;
+            MappedVector<int> view(path);
+
+            ASSERT_EQ(sz, view.size());
+            ASSERT_EQ(sz == 0, view.empty());
+            ASSERT_EQ(static_cast<ptrdiff_t>(sz), view.end() - view.begin());
+            for(size_t i = 0; i < sz; i++)
+                ASSERT_EQ(gt[i], view[i]);
+
+            // nothing is parsed or copied onto the heap
+            ASSERT_EQ(0UL, mh.n_allocs());
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+TEST(mapped_sort_is_private) {
+    Typegen t;
+
+    size_t sz = 0x3FFF;
+    std::vector<int> gt(sz);
+    for(size_t i = 0; i < sz; i++)
+        gt[i] = t.get<int>();
+    std::string path = write_records("sort", gt);
+
+    {
+        // with Vector's own iterator
+        using View = MappedVector<int, Vector<int>::iterator>;
+        View view(path);
+        std::sort(view.begin(), view.end());
+        ASSERT_TRUE(std::is_sorted(view.begin(), view.end()));
+
+        View moved(std::move(view));
+        ASSERT_TRUE(view.empty());
+        ASSERT_EQ(sz, moved.size());
+    }
+
+    // sorting in place never reaches the file
+    std::vector<int> after = read_records(path);
+    ASSERT_TRUE(gt == after);
+
+    std::remove(path.c_str());
+}
+
+// True when f throws an E
+template <typename E, typename F>
+static bool throws(F f) {
+    try {
+        f();
+    }
+    catch(const E &) {
+        return true;
+    }
+    return false;
+}
+
+TEST(mapped_errors) {
+    ASSERT_TRUE(throws<std::system_error>([] { MappedVector<int> view("mapped_missing.bin"); }));
+
+    std::string path = "mapped_partial.bin";
+    FILE * out = std::fopen(path.c_str(), "wb");
+    std::fputs("abcdef", out);
+    std::fclose(out);
+
+    ASSERT_TRUE(throws<std::invalid_argument>([&] { MappedVector<int> view(path); }));
+    MappedVector<char> chars(path);
+    ASSERT_EQ(6UL, chars.size());
+    ASSERT_EQ('f', chars.back());
+    ASSERT_TRUE(throws<std::out_of_range>([&] { chars.at(6); }));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,159 @@
+#include "executable.h"
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "box.h"
+
+TEST(range_constructor) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFFF);
+        std::list<std::string> src;
+        for(size_t i = 0; i < sz; i++)
+            src.push_back(t.get<std::string>(20));
+
+        Vector<std::string> vec(src.begin(), src.end());
+
+        ASSERT_EQ(sz, vec.size());
+        ASSERT_EQ(sz, vec.capacity());
+
+        size_t i = 0;
+        for(const std::string & s : src)
+            ASSERT_TRUE(s == vec[i++]);
+    }
+
+    // two integers still pick the fill constructor
+    Vector<int> filled(5, 1);
+    ASSERT_EQ(5UL, filled.size());
+    for(size_t i = 0; i < filled.size(); i++)
+        ASSERT_EQ(1, filled[i]);
+
+    // single pass ranges
+    std::istringstream in("3 1 4 1 5 9 2 6");
+    Vector<int> read((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+    ASSERT_EQ(8UL, read.size());
+    ASSERT_EQ(3, read[0]);
+    ASSERT_EQ(6, read[7]);
+}
+
+TEST(range_insert) {
+    Typegen t;
+
+    for(size_t k = 0; k < 300; k++) {
+        size_t sz = t.range<size_t>(0, 0xFF);
+        size_t count = t.range<size_t>(0, 0x1FF);
+        size_t extra = t.range<size_t>(0, 0x1FF);
+
+        Vector<Box<int>> vec;
+        vec.reserve(sz + extra);
+        std::vector<int> gt;
+        for(size_t i = 0; i < sz; i++) {
+            gt.push_back(t.get<int>());
+            vec.push_back(gt.back());
+        }
+
+        std::vector<Box<int>> batch;
+        std::vector<int> gt_batch;
+        for(size_t i = 0; i < count; i++) {
+            gt_batch.push_back(t.get<int>());
+            batch.push_back(gt_batch.back());
+        }
+
+        size_t loc = t.range<size_t>(0, sz + 1);
+        gt.insert(gt.begin() + loc, gt_batch.begin(), gt_batch.end());
+
+        size_t init_cap = vec.capacity();
+        {
+            Memhook mh;
+
+            auto pos = vec.insert(vec.begin() + loc, batch.begin(), batch.end());
+
+            ASSERT_EQ(loc, static_cast<size_t>(pos - vec.begin()));
+            // one copy per element and at most one new buffer
+            ASSERT_EQ(count + (sz + count > init_cap), mh.n_allocs());
+        }
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_EQ(gt[i], *vec[i]);
+    }
+}
+
+TEST(range_insert_input_iterator) {
+    Vector<int> vec(4, 0);
+    std::istringstream in("1 2 3");
+
+    vec.insert(vec.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+
+    std::vector<int> gt{0, 1, 2, 3, 0, 0, 0};
+    ASSERT_EQ(gt.size(), vec.size());
+    for(size_t i = 0; i < gt.size(); i++)
+        ASSERT_EQ(gt[i], vec[i]);
+}
+
+TEST(insert_fill_aliased) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(1, 0xFF);
+        Vector<std::string> vec;
+        std::vector<std::string> gt;
+        for(size_t i = 0; i < sz; i++) {
+            gt.push_back(t.get<std::string>(20));
+            vec.push_back(gt.back());
+        }
+
+        size_t from = t.range<size_t>(0, sz);
+        size_t loc = t.range<size_t>(0, sz + 1);
+        size_t count = t.range<size_t>(0, 0xFF);
+
+        gt.insert(gt.begin() + loc, count, std::string(gt[from]));
+        vec.insert(vec.begin() + loc, count, vec[from]);
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_TRUE(gt[i] == vec[i]);
+    }
+}
+
+TEST(assign) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFF);
+        size_t count = t.range<size_t>(0, 0x1FF);
+
+        Vector<std::string> vec;
+        for(size_t i = 0; i < sz; i++)
+            vec.push_back(t.get<std::string>(20));
+
+        std::string value = t.get<std::string>(20);
+        size_t init_cap = vec.capacity();
+
+        vec.assign(count, value);
+
+        ASSERT_EQ(count, vec.size());
+        ASSERT_EQ(count > init_cap ? count : init_cap, vec.capacity());
+        for(size_t i = 0; i < count; i++)
+            ASSERT_TRUE(value == vec[i]);
+
+        std::list<std::string> src;
+        size_t src_sz = t.range<size_t>(0, 0x1FF);
+        for(size_t i = 0; i < src_sz; i++)
+            src.push_back(t.get<std::string>(20));
+
+        init_cap = vec.capacity();
+        vec.assign(src.begin(), src.end());
+
+        ASSERT_EQ(src_sz, vec.size());
+        ASSERT_EQ(src_sz > init_cap ? src_sz : init_cap, vec.capacity());
+        size_t i = 0;
+        for(const std::string & s : src)
+            ASSERT_TRUE(s == vec[i++]);
+    }
+}
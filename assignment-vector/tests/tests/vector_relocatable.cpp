@@ -0,0 +1,89 @@
+#include "executable.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "box.h"
+
+// Box only owns a pointer, so it can be moved around byte-wise
+template <> struct is_trivially_relocatable<Box<int>> : std::true_type {};
+
+struct Point {
+    int x, y;
+};
+
+TEST(relocatable_traits) {
+    ASSERT_TRUE(is_trivially_relocatable<int>::value);
+    ASSERT_TRUE(is_trivially_relocatable<Point>::value);
+    ASSERT_TRUE(is_trivially_relocatable<Box<int>>::value);
+    ASSERT_FALSE(is_trivially_relocatable<Box<double>>::value);
+}
+
+TEST(relocatable_pod) {
+    Typegen t;
+
+    Vector<Point> vec;
+    std::vector<Point> gt;
+
+    for(size_t k = 0; k < 2000; k++) {
+        size_t op = t.range<size_t>(0, 4);
+        size_t pos = gt.empty() ? 0 : t.range<size_t>(0, gt.size());
+        Point p{t.get<int>(), t.get<int>()};
+
+        if(op == 0 || gt.empty()) {
+            vec.push_back(p);
+            gt.push_back(p);
+        } else if(op == 1) {
+            vec.insert(vec.begin() + pos, p);
+            gt.insert(gt.begin() + pos, p);
+        } else if(op == 2) {
+            vec.erase(vec.begin() + pos);
+            gt.erase(gt.begin() + pos);
+        } else {
+            size_t last = t.range<size_t>(pos, gt.size() + 1);
+            vec.erase(vec.begin() + pos, vec.begin() + last);
+            gt.erase(gt.begin() + pos, gt.begin() + last);
+        }
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++) {
+            ASSERT_EQ(gt[i].x, vec[i].x);
+            ASSERT_EQ(gt[i].y, vec[i].y);
+        }
+    }
+}
+
+TEST(relocatable_opt_in) {
+    Typegen t;
+
+    for(size_t k = 0; k < 50; k++) {
+        Memhook mh;
+        {
+            Vector<Box<int>> vec;
+            std::vector<int> gt;
+
+            for(size_t j = 0; j < 200; j++) {
+                size_t pos = gt.empty() ? 0 : t.range<size_t>(0, gt.size() + 1);
+                int el = t.get<int>();
+
+                if(t.get<bool>(0.7)) {
+                    vec.emplace(vec.begin() + pos, el);
+                    gt.insert(gt.begin() + pos, el);
+                } else if(!gt.empty()) {
+                    pos = t.range<size_t>(0, gt.size());
+                    size_t last = t.range<size_t>(pos, gt.size() + 1);
+                    vec.erase(vec.begin() + pos, vec.begin() + last);
+                    gt.erase(gt.begin() + pos, gt.begin() + last);
+                }
+            }
+
+            vec.shrink_to_fit();
+
+            ASSERT_EQ(gt.size(), vec.size());
+            for(size_t i = 0; i < gt.size(); i++)
+                ASSERT_EQ(gt[i], *vec[i]);
+        }
+        // relocation must neither leak nor double free the boxes
+        ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+    }
+}
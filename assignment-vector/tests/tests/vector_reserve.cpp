@@ -0,0 +1,133 @@
+#include "executable.h"
+
+#include <string>
+#include <vector>
+
+#include "box.h"
+
+TEST(reserve) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFF);
+        size_t cap = t.range<size_t>(0, 0xFFF);
+
+        Vector<Box<int>> vec;
+        std::vector<int> gt(sz);
+        for(size_t i = 0; i < sz; i++) {
+            gt[i] = t.get<int>();
+            vec.push_back(gt[i]);
+        }
+
+        size_t init_cap = vec.capacity();
+        {
+            Memhook mh;
+
+            vec.reserve(cap);
+
+            // only the new buffer, the elements are moved
+            ASSERT_EQ(static_cast<size_t>(cap > init_cap), mh.n_allocs());
+            ASSERT_EQ(static_cast<size_t>(cap > init_cap && init_cap != 0), mh.n_frees());
+        }
+
+        ASSERT_EQ(cap > init_cap ? cap : init_cap, vec.capacity());
+        ASSERT_EQ(sz, vec.size());
+        for(size_t i = 0; i < sz; i++)
+            ASSERT_EQ(gt[i], *vec[i]);
+
+        // no reallocation until the reserved capacity is used up
+        Memhook mh;
+        while(vec.size() < vec.capacity())
+            vec.push_back(Box<int>(nullptr));
+        ASSERT_EQ(0UL, mh.n_allocs());
+    }
+}
+
+TEST(shrink_to_fit) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFFF);
+
+        Vector<std::string> vec;
+        std::vector<std::string> gt(sz);
+        for(size_t i = 0; i < sz; i++) {
+            gt[i] = t.get<std::string>(20);
+            vec.push_back(gt[i]);
+        }
+
+        bool slack = vec.capacity() != sz;
+        {
+            Memhook mh;
+
+            vec.shrink_to_fit();
+
+            ASSERT_EQ(sz, vec.capacity());
+            ASSERT_TRUE(mh.n_allocs() <= static_cast<size_t>(slack && sz != 0));
+        }
+
+        ASSERT_EQ(sz, vec.size());
+        for(size_t i = 0; i < sz; i++)
+            ASSERT_TRUE(gt[i] == vec[i]);
+    }
+}
+
+TEST(resize) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFFF);
+        size_t count = t.range<size_t>(0, 0xFFF);
+        int fill = t.get<int>();
+
+        Vector<int> vec;
+        std::vector<int> gt(sz);
+        for(size_t i = 0; i < sz; i++) {
+            gt[i] = t.get<int>();
+            vec.push_back(gt[i]);
+        }
+
+        Vector<int> filled = vec;
+        std::vector<int> gt_filled = gt;
+
+        vec.resize(count);
+        gt.resize(count);
+        filled.resize(count, fill);
+        gt_filled.resize(count, fill);
+
+        ASSERT_EQ(count, vec.size());
+        ASSERT_EQ(count, filled.size());
+        ASSERT_TRUE(vec.capacity() >= count);
+
+        for(size_t i = 0; i < count; i++) {
+            ASSERT_EQ(gt[i], vec[i]);
+            ASSERT_EQ(gt_filled[i], filled[i]);
+        }
+    }
+}
+
+template <typename Policy>
+static void push_capacities(size_t n, std::vector<size_t> & caps) {
+    Vector<int, std::allocator<int>, Policy> vec;
+    for(size_t i = 0; i < n; i++) {
+        vec.push_back(static_cast<int>(i));
+        if(caps.empty() || caps.back() != vec.capacity())
+            caps.push_back(vec.capacity());
+    }
+}
+
+TEST(growth_policy) {
+    std::vector<size_t> doubling, half, chunk;
+
+    push_capacities<DoublingGrowth>(20, doubling);
+    push_capacities<HalfGrowth>(20, half);
+    push_capacities<ChunkGrowth<8>>(20, chunk);
+
+    ASSERT_TRUE((doubling == std::vector<size_t>{1, 2, 4, 8, 16, 32}));
+    ASSERT_TRUE((half == std::vector<size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+    ASSERT_TRUE((chunk == std::vector<size_t>{8, 16, 24}));
+
+    Vector<int, std::allocator<int>, ChunkGrowth<8>> vec;
+    vec.insert(vec.begin(), 20, 1);
+    ASSERT_EQ(24UL, vec.capacity());
+}
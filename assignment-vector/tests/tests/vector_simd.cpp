@@ -0,0 +1,130 @@
+#include "executable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "VectorAlgorithms.h"
+
+static const simd::Isa isas[] = { simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2 };
+
+TEST(simd_int) {
+    Typegen t;
+
+    for(simd::Isa isa : isas) {
+        simd::force_isa(isa);
+
+        for(size_t k = 0; k < 300; k++) {
+            size_t sz = t.range<size_t>(0, k < 200 ? 80 : 0x3FFF);
+            Vector<int> vec(sz);
+
+            // a narrow range so values repeat and searches hit
+            for(size_t i = 0; i < sz; i++)
+                vec[i] = t.range<int>(-50, 50);
+            int needle = t.range<int>(-60, 60);
+
+            std::vector<int> gt(vec.begin(), vec.end());
+
+            ASSERT_EQ(std::find(gt.begin(), gt.end(), needle) - gt.begin(), find(vec, needle) - vec.begin());
+            ASSERT_EQ(static_cast<size_t>(std::count(gt.begin(), gt.end(), needle)), count(vec, needle));
+            ASSERT_EQ(std::min_element(gt.begin(), gt.end()) - gt.begin(), min_element(vec) - vec.begin());
+            ASSERT_EQ(std::max_element(gt.begin(), gt.end()) - gt.begin(), max_element(vec) - vec.begin());
+            ASSERT_EQ(std::accumulate(gt.begin(), gt.end(), 0LL), sum(vec));
+        }
+    }
+
+    simd::force_isa(simd::detect_isa());
+}
+
+TEST(simd_int_extremes) {
+    for(simd::Isa isa : isas) {
+        simd::force_isa(isa);
+
+        // sums past INT_MAX must not wrap
+        Vector<int> big(1000, 2147483647);
+        big[500] = -2147483647 - 1;
+        ASSERT_EQ(999LL * 2147483647LL - 2147483648LL, sum(big));
+        ASSERT_EQ(500, min_element(big) - big.begin());
+        ASSERT_EQ(0, max_element(big) - big.begin());
+
+        Vector<int> empty;
+        ASSERT_TRUE(find(empty, 1) == empty.end());
+        ASSERT_TRUE(min_element(empty) == empty.end());
+        ASSERT_EQ(0UL, count(empty, 1));
+        ASSERT_EQ(0LL, sum(empty));
+    }
+
+    simd::force_isa(simd::detect_isa());
+}
+
+TEST(simd_float) {
+    Typegen t;
+
+    for(simd::Isa isa : isas) {
+        simd::force_isa(isa);
+
+        for(size_t k = 0; k < 300; k++) {
+            size_t sz = t.range<size_t>(0, k < 200 ? 80 : 0x3FFF);
+            Vector<float> vec(sz);
+
+            for(size_t i = 0; i < sz; i++)
+                vec[i] = static_cast<float>(t.range<int>(-50, 50)) / 4.0f;
+            float needle = static_cast<float>(t.range<int>(-60, 60)) / 4.0f;
+
+            std::vector<float> gt(vec.begin(), vec.end());
+
+            ASSERT_EQ(std::find(gt.begin(), gt.end(), needle) - gt.begin(), find(vec, needle) - vec.begin());
+            ASSERT_EQ(static_cast<size_t>(std::count(gt.begin(), gt.end(), needle)), count(vec, needle));
+            ASSERT_EQ(std::min_element(gt.begin(), gt.end()) - gt.begin(), min_element(vec) - vec.begin());
+            ASSERT_EQ(std::max_element(gt.begin(), gt.end()) - gt.begin(), max_element(vec) - vec.begin());
+            // quarters add exactly in any order at these magnitudes
+            ASSERT_EQ(std::accumulate(gt.begin(), gt.end(), 0.0f), sum(vec));
+        }
+    }
+
+    simd::force_isa(simd::detect_isa());
+}
+
+TEST(simd_float_nan) {
+    Typegen t;
+    const float nan = std::nanf("");
+
+    for(simd::Isa isa : isas) {
+        simd::force_isa(isa);
+
+        for(size_t k = 0; k < 300; k++) {
+            size_t sz = t.range<size_t>(1, k < 200 ? 80 : 0x3FFF);
+            Vector<float> vec(sz);
+            for(size_t i = 0; i < sz; i++)
+                vec[i] = static_cast<float>(t.range<int>(-50, 50)) / 4.0f;
+
+            // NaN first is the one the folds start from, so always try it
+            vec[0] = nan;
+            for(size_t n = t.range<size_t>(0, 4); n > 0; n--)
+                vec[t.range(sz)] = nan;
+
+            // which element is unspecified, but it is one of them
+            ASSERT_TRUE(min_element(vec) - vec.begin() < static_cast<ptrdiff_t>(sz));
+            ASSERT_TRUE(max_element(vec) - vec.begin() < static_cast<ptrdiff_t>(sz));
+        }
+
+        Vector<float> all_nan(37, nan);
+        ASSERT_EQ(0, min_element(all_nan) - all_nan.begin());
+        ASSERT_EQ(0, max_element(all_nan) - all_nan.begin());
+    }
+
+    simd::force_isa(simd::detect_isa());
+}
+
+TEST(simd_other_types) {
+    Typegen t;
+    Vector<double> vec(100);
+    for(size_t i = 0; i < vec.size(); i++)
+        vec[i] = t.range<double>(-1.0, 1.0);
+    vec[37] = 5.0;
+
+    ASSERT_EQ(37, max_element(vec) - vec.begin());
+    ASSERT_EQ(37, find(vec, 5.0) - vec.begin());
+    ASSERT_EQ(1UL, count(vec, 5.0));
+}
@@ -0,0 +1,188 @@
+#include "executable.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SmallVector.h"
+#include "box.h"
+
+TEST(small_no_allocations) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        std::vector<int> gt;
+        gt.reserve(8);
+
+        Memhook mh;
+        {
+            SmallVector<int, 8> vec;
+
+            for(size_t i = 0; i < 8; i++) {
+                int el = t.get<int>();
+                if(t.get<bool>()) {
+                    vec.push_back(el);
+                    gt.push_back(el);
+                } else {
+                    size_t loc = t.range<size_t>(0, gt.size() + 1);
+                    vec.insert(vec.begin() + loc, el);
+                    gt.insert(gt.begin() + loc, el);
+                }
+            }
+
+            SmallVector<int, 8> copy = vec;
+            SmallVector<int, 8> moved = std::move(copy);
+
+            ASSERT_TRUE(vec.is_small());
+            ASSERT_TRUE(moved.is_small());
+            ASSERT_EQ(8UL, vec.capacity());
+            ASSERT_EQ(0UL, copy.size());
+
+            for(size_t i = 0; i < gt.size(); i++) {
+                ASSERT_EQ(gt[i], vec[i]);
+                ASSERT_EQ(gt[i], moved[i]);
+            }
+        }
+        ASSERT_EQ(0UL, mh.n_allocs());
+    }
+}
+
+TEST(small_spill) {
+    Typegen t;
+
+    for(size_t k = 0; k < 100; k++) {
+        size_t sz = t.range<size_t>(0, 0xFF);
+        Memhook mh;
+        {
+            SmallVector<Box<int>, 4> vec;
+            std::vector<int> gt;
+
+            for(size_t i = 0; i < sz; i++) {
+                gt.push_back(t.get<int>());
+                vec.emplace_back(gt.back());
+            }
+
+            ASSERT_EQ(sz <= 4, vec.is_small());
+            ASSERT_EQ(gt.size(), vec.size());
+            for(size_t i = 0; i < gt.size(); i++)
+                ASSERT_EQ(gt[i], *vec[i]);
+
+            // a spilled buffer is stolen, not copied
+            size_t allocs = mh.n_allocs();
+            SmallVector<Box<int>, 4> moved = std::move(vec);
+            ASSERT_EQ(allocs, mh.n_allocs());
+            ASSERT_EQ(0UL, vec.size());
+            ASSERT_EQ(gt.size(), moved.size());
+
+            // back to the inline storage
+            if(moved.size() > 3)
+                moved.erase(moved.begin() + 3, moved.end());
+            moved.shrink_to_fit();
+            ASSERT_TRUE(moved.is_small());
+            for(size_t i = 0; i < moved.size(); i++)
+                ASSERT_EQ(gt[i], *moved[i]);
+        }
+        ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+    }
+}
+
+TEST(small_matches_vector) {
+    Typegen t;
+
+    SmallVector<std::string, 6> vec;
+    std::vector<std::string> gt;
+
+    for(size_t k = 0; k < 3000; k++) {
+        size_t op = t.range<size_t>(0, 6);
+        size_t loc = t.range<size_t>(0, gt.size() + 1);
+        std::string el = t.get<std::string>(10);
+
+        if(op == 0 || gt.empty()) {
+            vec.push_back(el);
+            gt.push_back(el);
+        } else if(op == 1) {
+            vec.insert(vec.begin() + loc, el);
+            gt.insert(gt.begin() + loc, el);
+        } else if(op == 2) {
+            size_t count = t.range<size_t>(0, 10);
+            vec.insert(vec.begin() + loc, count, el);
+            gt.insert(gt.begin() + loc, count, el);
+        } else if(op == 3) {
+            loc = t.range<size_t>(0, gt.size());
+            vec.erase(vec.begin() + loc);
+            gt.erase(gt.begin() + loc);
+        } else if(op == 4) {
+            loc = t.range<size_t>(0, gt.size());
+            size_t last = t.range<size_t>(loc, gt.size() + 1);
+            vec.erase(vec.begin() + loc, vec.begin() + last);
+            gt.erase(gt.begin() + loc, gt.begin() + last);
+        } else {
+            size_t count = t.range<size_t>(0, 12);
+            vec.resize(count, el);
+            gt.resize(count, el);
+            vec.shrink_to_fit();
+        }
+
+        ASSERT_EQ(gt.size(), vec.size());
+        for(size_t i = 0; i < gt.size(); i++)
+            ASSERT_TRUE(gt[i] == vec[i]);
+    }
+}
+
+// Forwards to std::allocator while recording how much is outstanding.
+// Copies compare equal only when they share a count, and do not follow
+// the elements on move assignment.
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    size_t * live;
+
+    explicit CountingAllocator(size_t * live) noexcept : live{live} {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> & other) noexcept : live{other.live} {}
+
+    T * allocate(size_t n) {
+        *live += n;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T * ptr, size_t n) noexcept {
+        *live -= n;
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    bool operator==(const CountingAllocator & other) const noexcept { return live == other.live; }
+    bool operator!=(const CountingAllocator & other) const noexcept { return live != other.live; }
+};
+
+TEST(small_move_assign_unequal_allocators) {
+    Typegen t;
+
+    for(size_t k = 0; k < 20; k++) {
+        size_t live_to = 0, live_from = 0;
+        {
+            using Small = SmallVector<int, 4, CountingAllocator<int>>;
+            Small to{CountingAllocator<int>(&live_to)};
+            Small from{CountingAllocator<int>(&live_from)};
+            std::vector<int> gt;
+
+            for(size_t i = 0, sz = t.range<size_t>(0, 100); i < sz; i++) {
+                gt.push_back(t.get<int>());
+                from.push_back(gt.back());
+            }
+
+            // from's buffer cannot be freed by to's allocator, so it stays
+            // with from and the elements are moved across
+            to = std::move(from);
+            ASSERT_TRUE(to.get_allocator() == CountingAllocator<int>(&live_to));
+            ASSERT_EQ(to.is_small() ? 0UL : to.capacity(), live_to);
+            ASSERT_EQ(from.is_small() ? 0UL : from.capacity(), live_from);
+            ASSERT_EQ(0UL, from.size());
+            ASSERT_EQ(gt.size(), to.size());
+            for(size_t i = 0; i < gt.size(); i++)
+                ASSERT_EQ(gt[i], to[i]);
+        }
+        ASSERT_EQ(0UL, live_to);
+        ASSERT_EQ(0UL, live_from);
+    }
+}